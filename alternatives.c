@@ -0,0 +1,222 @@
+//
+// Created by Mark on 10/19/2026
+//
+// Alternative routes with the via-node method, using one search from each end
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <float.h>
+
+#include "alternatives.h"
+#include "managegraph.h"
+#include "../debugmalloc.h"
+
+/*
+ * The graph is undirected (szak.txt gives every road in both directions), therefore the search from the
+ * endpoint gives the distances to the endpoint too. With the two trees every vertex v gives a via route:
+ * the shortest path from the start to v, then the shortest path from v to the end, of length
+ * distStart[v] + distEnd[v]. The optimal route is the via route of its own vertexes.
+ *
+ * The vertexes are tried in increasing order of their via length. A via route is accepted if
+ *  - it is at most maxStretch times longer than the optimal route,
+ *  - it has no loop,
+ *  - it shares at most maxOverlap times the optimal distance with each of the routes accepted before.
+ * Neighbouring vertexes usually give the same via route, so the vertexes of a route already tried are
+ * not tried again. The cost is the two searches, a sort and a few route walks.
+ */
+
+typedef struct{
+    double length;
+    int vertex;
+}Candidate;
+
+static int compareCandidates(const void *a, const void *b){
+    const Candidate *first = (const Candidate*) a;
+    const Candidate *second = (const Candidate*) b;
+    if (first->length < second->length)
+        return -1;
+    if (first->length > second->length)
+        return 1;
+    return first->vertex - second->vertex;
+}
+
+/*
+ * Builds the via route through a vertex in forward order
+ * @param path gets the vertexes from the start to the end
+ * @param cumulative gets the distance of each vertex from the start along the route
+ * @return the number of vertexes, -1 if the route has a loop
+ *
+ * @date 2026.10.19.
+ */
+static int viaRoute(int via, const double *distStart, const int *prevStart, const double *distEnd, const int *prevEnd,
+                    int *stamp, int stampValue, int *path, double *cumulative){
+    int count = 0;
+    //Start -> via, read backwards from the via vertex
+    for (int v = via; ; v = prevStart[v]) {
+        path[count++] = v;
+        if (prevStart[v] == v)
+            break;
+    }
+    for (int i = 0; i < count / 2; ++i) {
+        int temp = path[i];
+        path[i] = path[count - 1 - i];
+        path[count - 1 - i] = temp;
+    }
+    for (int i = 0; i < count; ++i)
+        cumulative[i] = distStart[path[i]];
+    //Via -> end, the end's previous vertex is itself
+    for (int v = via; prevEnd[v] != v; ) {
+        v = prevEnd[v];
+        path[count] = v;
+        cumulative[count] = distStart[via] + distEnd[via] - distEnd[v];
+        count++;
+    }
+    for (int i = 0; i < count; ++i) {
+        if (stamp[path[i]] == stampValue)
+            return -1;
+        stamp[path[i]] = stampValue;
+    }
+    return count;
+}
+
+typedef struct{
+    double *distStart, *distEnd;
+    int *prevStart, *prevEnd;
+    Candidate *candidates;
+    int *tried, *stamp, *path;
+    double *cumulative;
+    int *positions;     //place of the vertexes on the accepted routes, size for each route
+}Workspace;
+
+/*
+ * The work of alternativeRoutes on the allocated workspace, the parameters are the same
+ *
+ * @date 2026.10.19.
+ */
+static int findAlternatives(const AdjacencyList *adjacency, int startPoint, int endPoint, int k,
+                            double maxStretch, double maxOverlap, AlternativeRoute *routes, Workspace *w){
+    int size = adjacency->size;
+    if (!shortestPathTree(adjacency, startPoint, w->distStart, w->prevStart)
+        || !shortestPathTree(adjacency, endPoint, w->distEnd, w->prevEnd))
+        return -1;
+    double optimal = w->distStart[endPoint];
+    if (optimal == DBL_MAX)
+        return 0;
+    for (size_t i = 0; i < (size_t) k * size; ++i)
+        w->positions[i] = -1;
+
+    int candidateCount = 0;
+    for (int v = 0; v < size; ++v) {
+        if (w->distStart[v] != DBL_MAX && w->distEnd[v] != DBL_MAX && w->distStart[v] + w->distEnd[v] <= maxStretch * optimal){
+            w->candidates[candidateCount].length = w->distStart[v] + w->distEnd[v];
+            w->candidates[candidateCount].vertex = v;
+            candidateCount++;
+        }
+    }
+    qsort(w->candidates, candidateCount, sizeof(Candidate), compareCandidates);
+
+    //The first candidate is on an optimal route, so the optimal route is accepted first
+    int found = 0;
+    for (int c = 0; c < candidateCount && found < k; ++c) {
+        int via = w->candidates[c].vertex;
+        if (w->tried[via])
+            continue;
+        int count = viaRoute(via, w->distStart, w->prevStart, w->distEnd, w->prevEnd, w->stamp, c + 1, w->path, w->cumulative);
+        if (count == -1){
+            w->tried[via] = 1;
+            continue;
+        }
+        for (int i = 0; i < count; ++i)
+            w->tried[w->path[i]] = 1;
+
+        bool accepted = true;
+        for (int r = 0; r < found && accepted; ++r) {
+            const int *position = w->positions + (size_t) r * size;
+            double shared = 0;
+            for (int i = 1; i < count; ++i) {
+                int a = position[w->path[i-1]];
+                int b = position[w->path[i]];
+                if (a != -1 && b != -1 && abs(a - b) == 1)
+                    shared += w->cumulative[i] - w->cumulative[i-1];
+            }
+            if (shared > maxOverlap * optimal)
+                accepted = false;
+        }
+        if (!accepted)
+            continue;
+
+        int *route = (int*) malloc((count + 1) * sizeof(int));
+        if (route == NULL){
+            freeAlternativeRoutes(routes, found);
+            return -1;
+        }
+        int *position = w->positions + (size_t) found * size;
+        for (int i = 0; i < count; ++i) {
+            route[i] = w->path[count - 1 - i];
+            position[w->path[i]] = i;
+        }
+        route[count] = -1;
+        routes[found].route = route;
+        routes[found].distance = w->candidates[c].length;
+        found++;
+    }
+    return found;
+}
+
+/*
+ * Finds the optimal route and at most k-1 alternatives between two vertexes
+ * @param adjacency is the graph as neighbour lists
+ * @param startPoint and endPoint are the two ends
+ * @param k is the number of routes wanted, the optimal one included
+ * @param maxStretch is how many times longer an alternative can be than the optimal route (for example 1.3)
+ * @param maxOverlap is the largest part of the optimal distance a route may share with another one (for example 0.6)
+ * @param routes is an array of k, the routes are placed here in increasing order of distance, routes[0] is the optimal one
+ *
+ * @return the number of routes found
+ * Not-normal return values:
+ *  - 0: no connection between the two vertexes
+ *  - -1: error with malloc
+ *
+ * @date 2026.10.19.
+ */
+int alternativeRoutes(const AdjacencyList *adjacency, int startPoint, int endPoint, int k,
+                      double maxStretch, double maxOverlap, AlternativeRoute *routes){
+    int size = adjacency->size;
+    if (k < 1)
+        return 0;
+    Workspace w;
+    w.distStart = (double*) malloc(size * sizeof(double));
+    w.distEnd = (double*) malloc(size * sizeof(double));
+    w.prevStart = (int*) malloc(size * sizeof(int));
+    w.prevEnd = (int*) malloc(size * sizeof(int));
+    w.candidates = (Candidate*) malloc(size * sizeof(Candidate));
+    w.tried = (int*) calloc(size, sizeof(int));
+    w.stamp = (int*) calloc(size, sizeof(int));
+    w.path = (int*) malloc(2 * size * sizeof(int));
+    w.cumulative = (double*) malloc(2 * size * sizeof(double));
+    w.positions = (int*) malloc((size_t) k * size * sizeof(int));
+
+    int found = -1;
+    if (w.distStart != NULL && w.distEnd != NULL && w.prevStart != NULL && w.prevEnd != NULL && w.candidates != NULL
+        && w.tried != NULL && w.stamp != NULL && w.path != NULL && w.cumulative != NULL && w.positions != NULL)
+        found = findAlternatives(adjacency, startPoint, endPoint, k, maxStretch, maxOverlap, routes, &w);
+
+    free(w.distStart);
+    free(w.distEnd);
+    free(w.prevStart);
+    free(w.prevEnd);
+    free(w.candidates);
+    free(w.tried);
+    free(w.stamp);
+    free(w.path);
+    free(w.cumulative);
+    free(w.positions);
+    return found;
+}
+
+void freeAlternativeRoutes(AlternativeRoute *routes, int count){
+    for (int i = 0; i < count; ++i) {
+        free(routes[i].route);
+        routes[i].route = NULL;
+    }
+}
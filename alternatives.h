@@ -0,0 +1,19 @@
+//
+// Created by Mark on 10/19/2026
+//
+
+#include "managegraph.h"
+
+#ifndef ALTERNATIVES_H
+#define ALTERNATIVES_H
+
+typedef struct{
+    int *route;         //vertexes in reversed order, -1 signs the end (like the result of dijkstraAlgorithm)
+    double distance;
+}AlternativeRoute;
+
+int alternativeRoutes(const AdjacencyList *adjacency, int startPoint, int endPoint, int k,
+                      double maxStretch, double maxOverlap, AlternativeRoute *routes);
+void freeAlternativeRoutes(AlternativeRoute *routes, int count);
+
+#endif //ALTERNATIVES_H
@@ -0,0 +1,127 @@
+//
+// Created by Mark on 10/19/2026
+//
+// Shortest path trees of up to 16 sources in one search, the distances of a vertex are relaxed together
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <float.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "batchsearch.h"
+#include "managegraph.h"
+#include "minheap.h"
+#include "../debugmalloc.h"
+
+/*
+ * Every vertex has a vector of distances, one lane per source. When a vertex is taken out of the heap,
+ * its whole vector is relaxed along its edges, so one walk through the neighbour lists serves every source.
+ * A vertex is put into the heap with the smallest of its improved lanes. As a vertex may be taken out
+ * again when a further lane improves, the search corrects the labels until nothing changes,
+ * the result is the same as the one of shortestPathTree for every source.
+ */
+
+/*
+ * to = min(to, from + weight) lane by lane
+ * @param to is the vector of the neighbour
+ * @param from is the vector of the vertex
+ * @param weight is the length of the edge
+ * @param width is the number of lanes, 4, 8 or 16
+ * @return the smallest improved lane of to, DBL_MAX if none of them improved
+ *
+ * @date 2026.10.19.
+ */
+static double relaxLanes(double *to, const double *from, double weight, int width){
+#ifdef __SSE2__
+    const __m128d edge = _mm_set1_pd(weight);
+    const __m128d infinity = _mm_set1_pd(DBL_MAX);
+    __m128d key = infinity;
+    for (int l = 0; l < width; l += 2) {
+        __m128d candidate = _mm_add_pd(_mm_loadu_pd(from + l), edge);
+        __m128d old = _mm_loadu_pd(to + l);
+        __m128d less = _mm_cmplt_pd(candidate, old);
+        _mm_storeu_pd(to + l, _mm_min_pd(candidate, old));
+        key = _mm_min_pd(key, _mm_or_pd(_mm_and_pd(less, candidate), _mm_andnot_pd(less, infinity)));
+    }
+    key = _mm_min_sd(key, _mm_unpackhi_pd(key, key));
+    return _mm_cvtsd_f64(key);
+#else
+    double key = DBL_MAX;
+    for (int l = 0; l < width; ++l) {
+        double candidate = from[l] + weight;
+        if (candidate < to[l]){
+            to[l] = candidate;
+            if (candidate < key)
+                key = candidate;
+        }
+    }
+    return key;
+#endif
+}
+
+/*
+ * Dijkstra algorithm from several vertexes at once
+ * @param adjacency is the graph as neighbour lists
+ * @param sources are the start points, count is their number (1 to MAX_BATCH)
+ * @param dist gets the distances in row order: dist[s * adjacency->size + v] is the distance from sources[s] to v,
+ * DBL_MAX if there is no connection
+ * @return false if unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+bool batchShortestPaths(const AdjacencyList *adjacency, const int *sources, int count, double *dist){
+    if (count < 1 || count > MAX_BATCH)
+        return false;
+    int width = count <= 4 ? 4 : count <= 8 ? 8 : 16;
+    int size = adjacency->size;
+    double *labels = (double*) malloc((size_t) size * width * sizeof(double));
+    double *queued = (double*) malloc(size * sizeof(double)); //key of the vertex in the heap, DBL_MAX if it is not there
+    MinHeap heap;
+    if (labels == NULL || queued == NULL || !initHeap(&heap, size)){
+        free(labels);
+        free(queued);
+        return false;
+    }
+    for (size_t i = 0; i < (size_t) size * width; ++i)
+        labels[i] = DBL_MAX;
+    for (int v = 0; v < size; ++v)
+        queued[v] = DBL_MAX;
+    bool success = true;
+    for (int s = 0; s < count && success; ++s) {
+        labels[(size_t) sources[s] * width + s] = 0;
+        if (queued[sources[s]] != 0){
+            queued[sources[s]] = 0;
+            success = pushHeap(&heap, 0, sources[s]);
+        }
+    }
+
+    while (success && heap.size > 0){
+        HeapItem item = popHeap(&heap);
+        //Outdated item, the vertex is in the heap with a smaller key or it has already been relaxed
+        if (item.key != queued[item.vertex])
+            continue;
+        queued[item.vertex] = DBL_MAX;
+        const double *from = labels + (size_t) item.vertex * width;
+        for (int e = adjacency->offsets[item.vertex]; e < adjacency->offsets[item.vertex + 1] && success; ++e) {
+            int next = adjacency->targets[e];
+            double key = relaxLanes(labels + (size_t) next * width, from, adjacency->weights[e], width);
+            if (key < queued[next]){
+                queued[next] = key;
+                success = pushHeap(&heap, key, next);
+            }
+        }
+    }
+
+    if (success){
+        for (int v = 0; v < size; ++v) {
+            for (int s = 0; s < count; ++s)
+                dist[(size_t) s * size + v] = labels[(size_t) v * width + s];
+        }
+    }
+    freeHeap(&heap);
+    free(labels);
+    free(queued);
+    return success;
+}
@@ -0,0 +1,15 @@
+//
+// Created by Mark on 10/19/2026
+//
+
+#include <stdbool.h>
+#include "managegraph.h"
+
+#ifndef BATCHSEARCH_H
+#define BATCHSEARCH_H
+
+#define MAX_BATCH 16
+
+bool batchShortestPaths(const AdjacencyList *adjacency, const int *sources, int count, double *dist);
+
+#endif //BATCHSEARCH_H
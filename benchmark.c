@@ -0,0 +1,1442 @@
+//
+// Created by Mark on 10/19/2026
+//
+// Benchmarks of the search engines, started from the command line: route_planner --bench <name>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <limits.h>
+#include <SDL2/SDL.h>
+
+#include "benchmark.h"
+#include "managefile.h"
+#include "managegraph.h"
+#include "distancematrix.h"
+#include "hublabel.h"
+#include "deltastep.h"
+#include "isochrone.h"
+#include "alternatives.h"
+#include "placeindex.h"
+#include "compactgraph.h"
+#include "ingest.h"
+#include "batchsearch.h"
+#include "routewriter.h"
+#include "../debugmalloc.h"
+
+//The files of the loaded data, set by runBenchmark for the benchmarks which read them again
+static DataFiles dataFiles;
+
+/*
+ * @param start is a value of SDL_GetPerformanceCounter
+ * @return the milliseconds elapsed since start
+ *
+ * @date 2026.10.19.
+ */
+static double elapsedMs(Uint64 start){
+    return (double) (SDL_GetPerformanceCounter() - start) * 1000.0 / (double) SDL_GetPerformanceFrequency();
+}
+
+/*
+ * @return whether two distances are the same, apart from the rounding of the additions
+ *
+ * @date 2026.10.19.
+ */
+static bool sameDistance(double a, double b){
+    if (a == DBL_MAX || b == DBL_MAX)
+        return a == b;
+    return fabs(a - b) <= 1e-9 * (1 + fabs(a));
+}
+
+/*
+ * The thread counts of the scaling measurements: 1, 2, 4, ... and finally the number of CPUs
+ * @param threads is the current thread count
+ * @param cpus is the number of CPUs
+ * @return the next thread count, bigger than cpus at the end
+ *
+ * @date 2026.10.19.
+ */
+static int nextThreadCount(int threads, int cpus){
+    if (threads < cpus && threads * 2 > cpus)
+        return cpus;
+    return threads * 2;
+}
+
+/*
+ * Distance table of all the places: N*N calls of dijkstraAlgorithm compared to distanceMatrix
+ *
+ * @date 2026.10.19.
+ */
+static bool benchmarkDistanceMatrix(const Graph graph, const Position position){
+    (void) position;
+    int size = graph.size;
+    int *vertexes = (int*) malloc(size * sizeof(int));
+    double *naive = (double*) malloc((size_t) size * size * sizeof(double));
+    AdjacencyList adjacency;
+    if (vertexes == NULL || naive == NULL || !buildAdjacency(graph, &adjacency)){
+        free(vertexes);
+        free(naive);
+        return false;
+    }
+    for (int i = 0; i < size; ++i)
+        vertexes[i] = i;
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int s = 0; s < size; ++s) {
+        for (int t = 0; t < size; ++t) {
+            double dist = DBL_MAX;
+            int *route = dijkstraAlgorithm(graph, s, t, &dist);
+            if (route == NULL){
+                free(vertexes);
+                free(naive);
+                freeAdjacency(&adjacency);
+                return false;
+            }
+            naive[(size_t) s * size + t] = route[0] == -1 ? DBL_MAX : dist;
+            free(route);
+        }
+    }
+    printf("%dx%d table, dijkstraAlgorithm loop: %10.2f ms\n", size, size, elapsedMs(start));
+
+    bool success = true;
+    int cpus = SDL_GetCPUCount();
+    for (int threads = 1; threads <= cpus && success; threads = nextThreadCount(threads, cpus)) {
+        start = SDL_GetPerformanceCounter();
+        double *matrix = distanceMatrix(&adjacency, vertexes, size, vertexes, size, threads);
+        double time = elapsedMs(start);
+        if (matrix == NULL){
+            success = false;
+            break;
+        }
+        int mismatch = 0;
+        for (size_t i = 0; i < (size_t) size * size; ++i) {
+            if (!sameDistance(naive[i], matrix[i]))
+                mismatch++;
+        }
+        printf("%dx%d table, distanceMatrix, %2d threads: %10.2f ms, %d mismatches\n", size, size, threads, time, mismatch);
+        if (mismatch != 0)
+            success = false;
+        //The file has to give back the same matrix
+        if (success && threads == 1){
+            const char *filename = "matrix_bench.rpdm";
+            int rows = 0, columns = 0;
+            double *read = NULL;
+            if (writeDistanceMatrix(filename, matrix, size, size))
+                read = readDistanceMatrix(filename, &rows, &columns);
+            success = read != NULL && rows == size && columns == size
+                      && memcmp(read, matrix, (size_t) size * size * sizeof(double)) == 0;
+            printf("%s: written and read back %s\n", filename, success ? "without differences" : "with errors");
+            free(read);
+            remove(filename);
+        }
+        free(matrix);
+    }
+
+    free(vertexes);
+    free(naive);
+    freeAdjacency(&adjacency);
+    return success;
+}
+
+/*
+ * Overwrites offsets[1] of a hub label file (it follows the 16 byte header) and checks that it is rejected
+ * @param filename is the path of the file, it must not be loaded, it is mapped into memory
+ * @return whether loadHubLabels rejected the damaged file
+ *
+ * @date 2026.10.19.
+ */
+static bool damagedLabelsRejected(const char *filename){
+    FILE *fp = fopen(filename, "r+b");
+    if (fp == NULL)
+        return false;
+    uint32_t damaged = UINT32_MAX;
+    bool written = fseek(fp, 16 + sizeof(uint32_t), SEEK_SET) == 0 && fwrite(&damaged, sizeof(damaged), 1, fp) == 1;
+    if (fclose(fp) != 0 || !written)
+        return false;
+    HubLabels labels;
+    if (!loadHubLabels(filename, &labels))
+        return true;
+    freeHubLabels(&labels);
+    return false;
+}
+
+/*
+ * Sums the length of a route of dijkstraAlgorithm edge by edge in the fixed-point units of the hub labels
+ * @param graph is the graph
+ * @param route is the reversed route closed with -1
+ * @return the length in km, DBL_MAX if the route is empty (no connection)
+ *
+ * @date 2026.10.19.
+ */
+static double routeLabelDistance(const Graph graph, const int *route){
+    if (route[0] == -1)
+        return DBL_MAX;
+    uint64_t units = 0;
+    for (int i = 0; route[i+1] != -1; ++i)
+        units += (uint64_t) llround(graph.values[route[i+1]][route[i]] * LABEL_SCALE);
+    return (double) units / LABEL_SCALE;
+}
+
+/*
+ * Hub labels: preprocessing, file round trip, and random queries compared exactly to the routes of dijkstraAlgorithm
+ *
+ * @date 2026.10.19.
+ */
+static bool benchmarkHubLabels(const Graph graph, const Position position){
+    (void) position;
+    const char *filename = "hublabels.bin";
+    const int queries = 10000;
+    AdjacencyList adjacency;
+    if (graph.size == 0 || !buildAdjacency(graph, &adjacency))
+        return false;
+    bool built = buildHubLabelFile(filename, &adjacency);
+    freeAdjacency(&adjacency);
+    if (!built)
+        return false;
+    HubLabels labels;
+    bool loaded = loadHubLabels(filename, &labels);
+    if (!loaded){
+        remove(filename);
+        return false;
+    }
+
+    int *from = (int*) malloc(queries * sizeof(int));
+    int *to = (int*) malloc(queries * sizeof(int));
+    double *result = (double*) malloc(queries * sizeof(double));
+    if (from == NULL || to == NULL || result == NULL){
+        free(from);
+        free(to);
+        free(result);
+        freeHubLabels(&labels);
+        remove(filename);
+        return false;
+    }
+    srand(2019);
+    for (int i = 0; i < queries; ++i) {
+        from[i] = rand() % graph.size;
+        to[i] = rand() % graph.size;
+    }
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < queries; ++i)
+        result[i] = hubLabelDistance(&labels, from[i], to[i]);
+    double labelTime = elapsedMs(start);
+
+    bool success = true;
+    int mismatch = 0;
+    start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < queries && success; ++i) {
+        double dist = DBL_MAX;
+        int *route = dijkstraAlgorithm(graph, from[i], to[i], &dist);
+        if (route == NULL){
+            success = false;
+            break;
+        }
+        //The labels are summed in fixed-point, the same units summed along the route have to give the same bits
+        dist = routeLabelDistance(graph, route);
+        if (dist != result[i]){
+            if (mismatch < 10)
+                printf("Mismatch: %d -> %d, dijkstraAlgorithm: %.2f, hub labels: %.2f\n", from[i], to[i], dist, result[i]);
+            mismatch++;
+        }
+        free(route);
+    }
+    double dijkstraTime = elapsedMs(start);
+
+    printf("%d random queries, dijkstraAlgorithm: %10.2f ms (%.3f us / query)\n", queries, dijkstraTime, dijkstraTime * 1000 / queries);
+    printf("%d random queries, hub labels:        %10.2f ms (%.3f us / query), %d mismatches\n", queries, labelTime, labelTime * 1000 / queries, mismatch);
+    free(from);
+    free(to);
+    free(result);
+    freeHubLabels(&labels);
+    bool rejected = damagedLabelsRejected(filename);
+    printf("Damaged label file %s\n\n", rejected ? "rejected" : "NOT rejected");
+    remove(filename);
+    return success && mismatch == 0 && rejected;
+}
+
+/*
+ * Builds a road-like grid graph much larger than the bundled one: every vertex is connected to its
+ * right and lower neighbour with a random distance between 1 and 50 km
+ * @param width and height are the size of the grid
+ * @param adjacency is where the graph is built
+ * @return false if unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+static bool buildGridGraph(int width, int height, AdjacencyList *adjacency){
+    int size = width * height;
+    adjacency->size = size;
+    adjacency->offsets = (int*) malloc((size + 1) * sizeof(int));
+    adjacency->targets = (int*) malloc(4 * (size_t) size * sizeof(int));
+    adjacency->weights = (double*) malloc(4 * (size_t) size * sizeof(double));
+    if (adjacency->offsets == NULL || adjacency->targets == NULL || adjacency->weights == NULL){
+        freeAdjacency(adjacency);
+        return false;
+    }
+    //The weights of the edges to the right and down, the other two directions use the neighbours' ones
+    double *right = (double*) malloc(size * sizeof(double));
+    double *down = (double*) malloc(size * sizeof(double));
+    if (right == NULL || down == NULL){
+        free(right);
+        free(down);
+        freeAdjacency(adjacency);
+        return false;
+    }
+    srand(2019);
+    for (int i = 0; i < size; ++i) {
+        right[i] = (100 + rand() % 4901) / 100.0;
+        down[i] = (100 + rand() % 4901) / 100.0;
+    }
+    int edge = 0;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            int v = y * width + x;
+            adjacency->offsets[v] = edge;
+            if (y > 0){
+                adjacency->targets[edge] = v - width;
+                adjacency->weights[edge++] = down[v - width];
+            }
+            if (x > 0){
+                adjacency->targets[edge] = v - 1;
+                adjacency->weights[edge++] = right[v - 1];
+            }
+            if (x < width - 1){
+                adjacency->targets[edge] = v + 1;
+                adjacency->weights[edge++] = right[v];
+            }
+            if (y < height - 1){
+                adjacency->targets[edge] = v + width;
+                adjacency->weights[edge++] = down[v];
+            }
+        }
+    }
+    adjacency->offsets[size] = edge;
+    free(right);
+    free(down);
+    return true;
+}
+
+/*
+ * Delta-stepping on 1 to N threads compared to the sequential search: all the sources of the bundled graph
+ * for correctness, then one source on a large grid for the scaling
+ *
+ * @date 2026.10.19.
+ */
+static bool benchmarkDeltaStepping(const Graph graph, const Position position){
+    (void) position;
+    AdjacencyList adjacency;
+    if (!buildAdjacency(graph, &adjacency))
+        return false;
+    double *expected = (double*) malloc(graph.size * sizeof(double));
+    double *dist = (double*) malloc(graph.size * sizeof(double));
+    bool success = expected != NULL && dist != NULL;
+    int mismatch = 0;
+    int cpus = SDL_GetCPUCount();
+    for (int s = 0; s < graph.size && success; ++s) {
+        success = shortestPathTree(&adjacency, s, expected, NULL)
+                  && deltaStepping(&adjacency, s, 0, s % 4 + 1, dist);
+        for (int i = 0; i < graph.size && success; ++i) {
+            if (!sameDistance(expected[i], dist[i]))
+                mismatch++;
+        }
+    }
+    free(expected);
+    free(dist);
+    freeAdjacency(&adjacency);
+    if (!success)
+        return false;
+    printf("Bundled graph, all %d sources: %d mismatches\n", graph.size, mismatch);
+
+    const int width = 700, height = 700;
+    if (!buildGridGraph(width, height, &adjacency))
+        return false;
+    expected = (double*) malloc(adjacency.size * sizeof(double));
+    dist = (double*) malloc(adjacency.size * sizeof(double));
+    success = expected != NULL && dist != NULL;
+    int source = adjacency.size / 2 + width / 2;
+    if (success){
+        Uint64 start = SDL_GetPerformanceCounter();
+        success = shortestPathTree(&adjacency, source, expected, NULL);
+        printf("%dx%d grid, sequential Dijkstra:       %10.2f ms\n", width, height, elapsedMs(start));
+    }
+    for (int threads = 1; threads <= cpus && success; threads = nextThreadCount(threads, cpus)) {
+        Uint64 start = SDL_GetPerformanceCounter();
+        success = deltaStepping(&adjacency, source, 0, threads, dist);
+        double time = elapsedMs(start);
+        int gridMismatch = 0;
+        for (int i = 0; i < adjacency.size && success; ++i) {
+            if (!sameDistance(expected[i], dist[i]))
+                gridMismatch++;
+        }
+        printf("%dx%d grid, delta-stepping, %2d threads: %10.2f ms, %d mismatches\n", width, height, threads, time, gridMismatch);
+        mismatch += gridMismatch;
+    }
+    free(expected);
+    free(dist);
+    freeAdjacency(&adjacency);
+    return success && mismatch == 0;
+}
+
+/*
+ * Whether a point is inside the region of reachableRegion or on its edge. The hull turns to the left, so the
+ * point has to be on the left of every edge; a region of 1 or 2 points is a point or a segment.
+ *
+ * @date 2026.10.19.
+ */
+static bool insideRegion(const Border *region, Sint16 x, Sint16 y){
+    for (int i = 0; i < region->size; ++i) {
+        int j = (i + 1) % region->size;
+        long cross = (long) (region->x[j] - region->x[i]) * (y - region->y[i]) - (long) (region->y[j] - region->y[i]) * (x - region->x[i]);
+        if (cross < 0 || (region->size < 3 && cross != 0))
+            return false;
+    }
+    if (region->size < 3){
+        int last = region->size - 1;
+        return x >= SDL_min(region->x[0], region->x[last]) && x <= SDL_max(region->x[0], region->x[last])
+               && y >= SDL_min(region->y[0], region->y[last]) && y <= SDL_max(region->y[0], region->y[last]);
+    }
+    return true;
+}
+
+/*
+ * Bounded searches with different radii, each from several sources
+ * @param adjacency is the graph
+ * @param position is the vertex array of the graph, then every reached place has to be inside the region
+ *        of reachableRegion, NULL: the graph has no places
+ * @param name is printed in front of the results
+ * @param sources and sourceCount are the starting points
+ * @return false if unable to allocate memory or a result differs from the full search
+ *
+ * @date 2026.10.19.
+ */
+static bool measureIsochrones(const AdjacencyList *adjacency, const Position *position, const char *name, const int *sources, int sourceCount){
+    const double radii[] = {10, 25, 50, 100, 200, 1000};
+    double *expected = (double*) malloc(adjacency->size * sizeof(double));
+    SearchSpace space;
+    if (expected == NULL || !initSearchSpace(&space, adjacency->size)){
+        free(expected);
+        return false;
+    }
+    bool success = true;
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int s = 0; s < sourceCount && success; ++s)
+        success = shortestPathTree(adjacency, sources[s], expected, NULL);
+    printf("%s, full search:      %10.2f us / query\n", name, elapsedMs(start) * 1000 / sourceCount);
+
+    for (int r = 0; r < (int) (sizeof(radii) / sizeof(radii[0])) && success; ++r) {
+        long reached = 0, touched = 0;
+        double time = 0;
+        int mismatch = 0, outside = 0;
+        for (int s = 0; s < sourceCount && success; ++s) {
+            ReachableSet reachable;
+            start = SDL_GetPerformanceCounter();
+            success = reachableWithin(adjacency, &space, sources[s], radii[r], &reachable);
+            time += elapsedMs(start);
+            if (!success || !shortestPathTree(adjacency, sources[s], expected, NULL)){
+                success = false;
+                break;
+            }
+            reached += reachable.count;
+            touched += space.touchedCount;
+            int inside = 0;
+            for (int i = 0; i < adjacency->size; ++i) {
+                if (expected[i] <= radii[r])
+                    inside++;
+            }
+            for (int i = 0; i < reachable.count; ++i) {
+                if (!sameDistance(expected[reachable.vertexes[i]], reachable.dists[i]))
+                    mismatch++;
+            }
+            if (inside != reachable.count)
+                mismatch++;
+            if (position != NULL){
+                const int windowY = 700;
+                Border region;
+                success = reachableRegion(&reachable, *position, windowY, &region);
+                for (int i = 0; i < reachable.count && success; ++i) {
+                    Location place = position->values[reachable.vertexes[i]];
+                    if (!insideRegion(&region, (Sint16) place.x, (Sint16) (windowY - place.y))){
+                        outside++;
+                        break;
+                    }
+                }
+                if (success){
+                    free(region.x);
+                    free(region.y);
+                }
+            }
+            freeReachableSet(&reachable);
+        }
+        printf("%s, radius %6.0f km: %10.2f us / query, %9.1f places reached, %9.1f touched, %d mismatches",
+               name, radii[r], time * 1000 / sourceCount, (double) reached / sourceCount, (double) touched / sourceCount, mismatch);
+        if (position != NULL)
+            printf(", %d regions missing a place", outside);
+        printf("\n");
+        if (mismatch != 0 || outside != 0)
+            success = false;
+    }
+    free(expected);
+    freeSearchSpace(&space);
+    return success;
+}
+
+/*
+ * Isochrones of all the places of the bundled graph, every reached place has to be inside its region,
+ * then of random places of a large grid
+ *
+ * @date 2026.10.19.
+ */
+static bool benchmarkIsochrones(const Graph graph, const Position position){
+    AdjacencyList adjacency;
+    int *sources = (int*) malloc((graph.size > 50 ? graph.size : 50) * sizeof(int));
+    if (sources == NULL || !buildAdjacency(graph, &adjacency)){
+        free(sources);
+        return false;
+    }
+    for (int i = 0; i < graph.size; ++i)
+        sources[i] = i;
+    bool success = measureIsochrones(&adjacency, &position, "Bundled graph", sources, graph.size);
+    freeAdjacency(&adjacency);
+
+    if (success && buildGridGraph(300, 300, &adjacency)){
+        srand(2019);
+        for (int i = 0; i < 50; ++i)
+            sources[i] = rand() % adjacency.size;
+        success = measureIsochrones(&adjacency, NULL, "300x300 grid ", sources, 50);
+        freeAdjacency(&adjacency);
+    } else
+        success = false;
+    free(sources);
+    return success;
+}
+
+/*
+ * The distance of the edges of a route which are in the other route too, in any direction
+ * @param first and second are routes ending with -1
+ *
+ * @date 2026.10.19.
+ */
+static double sharedDistance(const Graph graph, const int *first, const int *second){
+    double shared = 0;
+    for (int i = 1; second[i] != -1; ++i) {
+        for (int j = 1; first[j] != -1; ++j) {
+            if ((first[j-1] == second[i-1] && first[j] == second[i]) || (first[j-1] == second[i] && first[j] == second[i-1])){
+                shared += graph.values[second[i-1]][second[i]];
+                break;
+            }
+        }
+    }
+    return shared;
+}
+
+/*
+ * Whether a route visits a vertex twice
+ * @param seen is an array of the graph's size, the vertexes of the route are set to stamp in it
+ *
+ * @date 2026.10.19.
+ */
+static bool hasLoop(const int *route, int *seen, int stamp){
+    for (int i = 0; route[i] != -1; ++i) {
+        if (seen[route[i]] == stamp)
+            return true;
+        seen[route[i]] = stamp;
+    }
+    return false;
+}
+
+/*
+ * Three routes between random pairs of places compared to a single search. The optimal route has to match
+ * dijkstraAlgorithm, every route's distance has to be the sum of its edges, and the alternatives have to keep
+ * the limits of the stretch and of the overlap, without loops.
+ *
+ * @date 2026.10.19.
+ */
+static bool benchmarkAlternatives(const Graph graph, const Position position){
+    (void) position;
+    const int queries = 2000;
+    const int k = 3;
+    const double maxStretch = 1.3;
+    const double maxOverlap = 0.6;
+    AdjacencyList adjacency;
+    double *dist = (double*) malloc(graph.size * sizeof(double));
+    int *seen = (int*) malloc(graph.size * sizeof(int));
+    if (dist == NULL || seen == NULL || graph.size == 0 || !buildAdjacency(graph, &adjacency)){
+        free(dist);
+        free(seen);
+        return false;
+    }
+    for (int i = 0; i < graph.size; ++i)
+        seen[i] = -1;
+
+    srand(2019);
+    bool success = true;
+    int mismatch = 0, violation = 0, routeCount = 0, pairs = 0;
+    double stretch = 0, alternativeTime = 0, singleTime = 0;
+    for (int q = 0; q < queries && success; ++q) {
+        int from = rand() % graph.size;
+        int to = rand() % graph.size;
+        Uint64 start = SDL_GetPerformanceCounter();
+        success = shortestPathTree(&adjacency, from, dist, NULL);
+        singleTime += elapsedMs(start);
+
+        AlternativeRoute routes[k];
+        start = SDL_GetPerformanceCounter();
+        int found = alternativeRoutes(&adjacency, from, to, k, maxStretch, maxOverlap, routes);
+        alternativeTime += elapsedMs(start);
+        if (found == -1 || !success){
+            success = false;
+            break;
+        }
+        if (found == 0){
+            if (dist[to] != DBL_MAX)
+                mismatch++;
+            continue;
+        }
+        pairs++;
+        routeCount += found;
+        if (!sameDistance(routes[0].distance, dist[to]))
+            mismatch++;
+        for (int r = 0; r < found; ++r) {
+            double sum = 0;
+            int j;
+            for (j = 1; routes[r].route[j] != -1; ++j)
+                sum += graph.values[routes[r].route[j-1]][routes[r].route[j]];
+            if (!sameDistance(sum, routes[r].distance) || routes[r].route[0] != to || routes[r].route[j-1] != from)
+                mismatch++;
+            if (r > 0 && routes[0].distance > 0)
+                stretch += routes[r].distance / routes[0].distance;
+            //The limits are relative to the optimal distance, sameDistance allows the rounding
+            if (routes[r].distance > maxStretch * dist[to] && !sameDistance(routes[r].distance, maxStretch * dist[to]))
+                violation++;
+            if (hasLoop(routes[r].route, seen, q * k + r))
+                violation++;
+            for (int other = 0; other < r; ++other) {
+                double shared = sharedDistance(graph, routes[other].route, routes[r].route);
+                if (shared > maxOverlap * dist[to] && !sameDistance(shared, maxOverlap * dist[to]))
+                    violation++;
+            }
+        }
+        freeAlternativeRoutes(routes, found);
+    }
+    printf("%d random pairs, one search:          %8.2f us / query\n", queries, singleTime * 1000 / queries);
+    printf("%d random pairs, %d alternative routes: %8.2f us / query, %.2f routes found on average, "
+           "average stretch of the alternatives: %.3f, %d mismatches\n", queries, k, alternativeTime * 1000 / queries,
+           pairs ? (double) routeCount / pairs : 0.0, routeCount > pairs ? stretch / (routeCount - pairs) : 0.0, mismatch);
+    printf("Routes over the stretch %.1f or the overlap %.1f limit, or with a loop: %d\n", maxStretch, maxOverlap, violation);
+    free(dist);
+    free(seen);
+    freeAdjacency(&adjacency);
+    return success && mismatch == 0 && violation == 0;
+}
+
+/*
+ * Name lookups with the index compared to scanning the position array, and accented spellings
+ *
+ * @date 2026.10.19.
+ */
+static bool benchmarkPlaceIndex(const Graph graph, const Position position){
+    (void) graph;
+    const int rounds = 200;
+    PlaceIndex index;
+    if (!buildPlaceIndex(position, &index))
+        return false;
+
+    int mismatch = 0;
+    //Accented and lower case spellings, the expected place numbers are from csp.txt
+    const char *spellings[] = {"Győr", "gyor", "PÉCS", "Baja", "székesfehérvár", "Nyíregyháza", "KecskeMÉT"};
+    const int expected[] = {4, 4, 1, 11, 6, 107, 93};
+    for (int i = 0; i < (int) (sizeof(expected) / sizeof(expected[0])); ++i) {
+        int vertex = findPlace(&index, spellings[i]);
+        if (vertex == -1 || position.values[vertex].num != expected[i]){
+            printf("Not found: %s\n", spellings[i]);
+            mismatch++;
+        }
+    }
+
+    long found = 0;
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int r = 0; r < rounds; ++r) {
+        for (int i = 0; i < position.size; ++i) {
+            int vertex = -1;
+            for (int j = 0; j < position.size && vertex == -1; ++j) {
+                if (strcmp(position.values[j].name, position.values[i].name) == 0)
+                    vertex = j;
+            }
+            found += vertex;
+        }
+    }
+    double scanTime = elapsedMs(start);
+    long indexed = 0;
+    start = SDL_GetPerformanceCounter();
+    for (int r = 0; r < rounds; ++r) {
+        for (int i = 0; i < position.size; ++i)
+            indexed += findPlace(&index, position.values[i].name);
+    }
+    double indexTime = elapsedMs(start);
+    if (found != indexed)
+        mismatch++;
+    int lookups = rounds * position.size;
+    printf("%d exact lookups, scanning:  %8.3f us / lookup\n", lookups, scanTime * 1000 / lookups);
+    printf("%d exact lookups, hash index: %8.3f us / lookup\n", lookups, indexTime * 1000 / lookups);
+
+    //All the one, two and three letter beginnings of the names
+    long scanned = 0, matched = 0;
+    double scanPrefix = 0, indexPrefix = 0;
+    for (int length = 1; length <= 3; ++length) {
+        for (int i = 0; i < position.size; ++i) {
+            char prefix[4];
+            snprintf(prefix, length + 1, "%s", position.values[i].name);
+            start = SDL_GetPerformanceCounter();
+            for (int j = 0; j < position.size; ++j) {
+                if (strncmp(position.values[j].name, prefix, strlen(prefix)) == 0)
+                    scanned++;
+            }
+            scanPrefix += elapsedMs(start);
+            int first;
+            start = SDL_GetPerformanceCounter();
+            matched += findPlacesByPrefix(&index, prefix, &first);
+            indexPrefix += elapsedMs(start);
+        }
+    }
+    if (scanned != matched)
+        mismatch++;
+    printf("%d prefix lookups, scanning:     %8.3f us / lookup\n", 3 * position.size, scanPrefix * 1000 / (3 * position.size));
+    printf("%d prefix lookups, sorted index: %8.3f us / lookup, %d mismatches\n", 3 * position.size, indexPrefix * 1000 / (3 * position.size), mismatch);
+    freePlaceIndex(&index);
+    return mismatch == 0;
+}
+
+/*
+ * One-to-all searches on the neighbour lists and on the compact graph from several sources
+ * @return false if unable to allocate memory or the distances differ
+ *
+ * @date 2026.10.19.
+ */
+static bool compareCompactSearch(const AdjacencyList *adjacency, const CompactGraph *compact, const char *name, int sources){
+    double *expected = (double*) malloc(adjacency->size * sizeof(double));
+    double *dist = (double*) malloc(adjacency->size * sizeof(double));
+    bool success = expected != NULL && dist != NULL;
+    double listTime = 0, compactTime = 0;
+    int mismatch = 0;
+    srand(2019);
+    for (int s = 0; s < sources && success; ++s) {
+        int source = rand() % adjacency->size;
+        Uint64 start = SDL_GetPerformanceCounter();
+        success = shortestPathTree(adjacency, source, expected, NULL);
+        listTime += elapsedMs(start);
+        start = SDL_GetPerformanceCounter();
+        success = success && compactShortestPathTree(compact, source, dist);
+        compactTime += elapsedMs(start);
+        for (int i = 0; i < adjacency->size && success; ++i) {
+            if (!sameDistance(expected[i], dist[i]))
+                mismatch++;
+        }
+    }
+    printf("%s, one-to-all search, neighbour lists: %10.3f ms\n", name, listTime / sources);
+    printf("%s, one-to-all search, compact graph:   %10.3f ms, %d mismatches\n", name, compactTime / sources, mismatch);
+    free(expected);
+    free(dist);
+    return success && mismatch == 0;
+}
+
+/*
+ * Memory footprint and search speed of the compact graph compared to the adjacency matrix and the
+ * neighbour lists, on the bundled graph and on a large grid
+ *
+ * @date 2026.10.19.
+ */
+static bool benchmarkCompactGraph(const Graph graph, const Position position){
+    AdjacencyList adjacency;
+    CompactGraph compact;
+    if (!buildAdjacency(graph, &adjacency))
+        return false;
+    if (!buildCompactGraph(&adjacency, &position, &compact)){
+        freeAdjacency(&adjacency);
+        return false;
+    }
+    size_t matrixBytes = (size_t) graph.size * graph.size * sizeof(double) + graph.size * sizeof(double*);
+    size_t listBytes = (graph.size + 1) * sizeof(int) + (size_t) adjacency.offsets[graph.size] * (sizeof(int) + sizeof(double));
+    size_t placeBytes = graph.size * sizeof(Location);
+    printf("Bundled graph, adjacency matrix + places: %10zu bytes\n", matrixBytes + placeBytes);
+    printf("Bundled graph, neighbour lists + places:  %10zu bytes\n", listBytes + placeBytes);
+    printf("Bundled graph, compact graph with places: %10zu bytes\n", compactGraphSize(&compact));
+
+    //The decoded places have to be within a quantization step
+    int mismatch = 0;
+    for (int i = 0; i < graph.size; ++i) {
+        Location place;
+        compactLocation(&compact, i, &place);
+        if (fabs(place.x - position.values[i].x) > compact.stepX || fabs(place.y - position.values[i].y) > compact.stepY
+            || strcmp(place.name, position.values[i].name) != 0 || place.num != position.values[i].num)
+            mismatch++;
+    }
+    bool success = mismatch == 0 && compareCompactSearch(&adjacency, &compact, "Bundled graph", 200);
+    freeCompactGraph(&compact);
+
+    //Every 10th slot emptied like the missing numbers of csp.txt: they have to stay empty
+    Position holes = {position.size, (Location*) malloc(position.size * sizeof(Location))};
+    if (success && holes.values != NULL){
+        memcpy(holes.values, position.values, position.size * sizeof(Location));
+        for (int i = 0; i < holes.size; i += 10)
+            memset(&holes.values[i], 0, sizeof(Location));
+        success = buildCompactGraph(&adjacency, &holes, &compact);
+        for (int i = 0; i < holes.size && success; ++i) {
+            Location place;
+            compactLocation(&compact, i, &place);
+            if (place.num != holes.values[i].num || strcmp(place.name, holes.values[i].name) != 0
+                || (place.num != 0 && (fabs(place.x - holes.values[i].x) > compact.stepX || fabs(place.y - holes.values[i].y) > compact.stepY)))
+                mismatch++;
+        }
+        if (success)
+            freeCompactGraph(&compact);
+    } else
+        success = false;
+    free(holes.values);
+    success = success && mismatch == 0;
+    freeAdjacency(&adjacency);
+
+    const int width = 700, height = 700;
+    if (success && buildGridGraph(width, height, &adjacency)){
+        if (buildCompactGraph(&adjacency, NULL, &compact)){
+            listBytes = (adjacency.size + 1) * sizeof(int) + (size_t) adjacency.offsets[adjacency.size] * (sizeof(int) + sizeof(double));
+            printf("%dx%d grid, adjacency matrix: %14.0f bytes (not built)\n", width, height, (double) adjacency.size * adjacency.size * sizeof(double));
+            printf("%dx%d grid, neighbour lists:  %14zu bytes\n", width, height, listBytes);
+            printf("%dx%d grid, compact graph:    %14zu bytes\n", width, height, compactGraphSize(&compact));
+            success = compareCompactSearch(&adjacency, &compact, "700x700 grid ", 5);
+            freeCompactGraph(&compact);
+        } else
+            success = false;
+        freeAdjacency(&adjacency);
+    } else
+        success = false;
+    if (mismatch != 0)
+        printf("%d places decoded wrong\n", mismatch);
+    return success;
+}
+
+/*
+ * Writes a width x height grid graph in szak.txt format and its places in csp.txt format
+ * Every 50000th line of the graph is malformed: garbage in the lines 100000, 200000, ..., and a vertex out of
+ * range in the lines 50000, 150000, .... The last place has a huge number,
+ * it has to be a malformed line instead of a huge array.
+ * @return false if the files cannot be written
+ *
+ * @date 2026.10.19.
+ */
+static bool writeIngestFiles(const char *graphFile, const char *placeFile, int width, int height){
+    FILE *edges = fopen(graphFile, "w");
+    FILE *places = fopen(placeFile, "w");
+    if (edges == NULL || places == NULL){
+        if (edges != NULL)
+            fclose(edges);
+        if (places != NULL)
+            fclose(places);
+        return false;
+    }
+    srand(2019);
+    int size = width * height;
+    int line = 0;
+    for (int v = 0; v < size; ++v) {
+        int x = v % width, y = v / width;
+        for (int direction = 0; direction < 2; ++direction) {
+            int w = direction == 0 ? v + 1 : v + width;
+            if ((direction == 0 && x == width - 1) || (direction == 1 && y == height - 1))
+                continue;
+            line++;
+            if (line % 100000 == 0)
+                fprintf(edges, "%-10d %-10s %-10d %-12.2f\n", line, "hiba", w + 1, 1.0); //error
+            else if (line % 100000 == 50000)
+                fprintf(edges, "%-10d %-10d %-10d %-12.2f\n", line, size + 1, w + 1, 1.0);
+            else
+                fprintf(edges, "%-10d %-10d %-10d %-12.2f\n", line, v + 1, w + 1, (rand() % 4900 + 100) / 100.0);
+        }
+        fprintf(places, "%-10d P%-9d %-21.2f %-21.2f\n", v + 1, v + 1,
+                400000 + rand() % 500000 + (rand() % 100) / 100.0, 50000 + rand() % 300000 + (rand() % 100) / 100.0);
+    }
+    fprintf(places, "%-10d P%-9d %-21.2f %-21.2f\n", INT_MAX, 0, 400000.0, 50000.0);
+    fclose(edges);
+    fclose(places);
+    return true;
+}
+
+/*
+ * The old way of reading: fscanf-style parsing line by line on one thread, malformed lines are skipped
+ * @return the number of edges, -1 if the file cannot be read or unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+static int referenceEdges(const char *filename, int size, Edge **edges){
+    FILE *fp = fopen(filename, "r");
+    if (fp == NULL)
+        return -1;
+    int count = 0, capacity = 1024;
+    *edges = (Edge*) malloc(capacity * sizeof(Edge));
+    char line[256];
+    while (*edges != NULL && fgets(line, sizeof(line), fp) != NULL){
+        int num;
+        Edge edge;
+        if (sscanf(line, "%d %d %d %lf", &num, &edge.first, &edge.second, &edge.weight) != 4
+            || edge.first < 1 || edge.first > size || edge.second < 1 || edge.second > size)
+            continue;
+        if (count == capacity){
+            capacity *= 2;
+            Edge *bigger = (Edge*) realloc(*edges, capacity * sizeof(Edge));
+            if (bigger == NULL)
+                free(*edges);
+            *edges = bigger;
+            if (bigger == NULL)
+                break;
+        }
+        edge.first--;
+        edge.second--;
+        (*edges)[count++] = edge;
+    }
+    fclose(fp);
+    return *edges == NULL ? -1 : count;
+}
+
+/*
+ * The old way of reading the places, see referenceEdges
+ * @return the number of places, -1 if the file cannot be read or unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+static int referencePlaces(const char *filename, int size, Location *places){
+    FILE *fp = fopen(filename, "r");
+    if (fp == NULL)
+        return -1;
+    int count = 0;
+    char line[256];
+    Location temp;
+    while (fgets(line, sizeof(line), fp) != NULL){
+        if (sscanf(line, "%d %50s %lf %lf", &temp.num, temp.name, &temp.x, &temp.y) == 4 && temp.num >= 1 && temp.num <= size){
+            places[temp.num - 1] = temp;
+            count++;
+        }
+    }
+    fclose(fp);
+    return count;
+}
+
+static double megabytesPerSecond(long long bytes, double ms){
+    return ms > 0 ? bytes / 1048576.0 / (ms / 1000.0) : 0;
+}
+
+/*
+ * Compares the edges read by the threads to the reference, the order of the lines has to be kept
+ *
+ * @date 2026.10.19.
+ */
+static bool sameEdges(const EdgeList *edges, const Edge *reference, int count){
+    if (edges->count != count)
+        return false;
+    for (int i = 0; i < count; ++i) {
+        if (edges->values[i].first != reference[i].first || edges->values[i].second != reference[i].second
+            || edges->values[i].weight != reference[i].weight)
+            return false;
+    }
+    return true;
+}
+
+/*
+ * Compares the neighbour lists read from szak.txt to the ones built from the adjacency matrix,
+ * then measures the ingestion of a generated file with millions of lines on 1 to N threads
+ *
+ * @date 2026.10.19.
+ */
+static bool benchmarkIngest(const Graph graph, const Position position){
+    (void) position;
+    AdjacencyList fromMatrix, fromFile;
+    if (!buildAdjacency(graph, &fromMatrix))
+        return false;
+    if (!ingestGraph(dataFiles.graph, graph.size, 0, &fromFile, NULL)){
+        freeAdjacency(&fromMatrix);
+        return false;
+    }
+    double *distMatrix = (double*) malloc(graph.size * sizeof(double));
+    double *distFile = (double*) malloc(graph.size * sizeof(double));
+    int mismatch = 0;
+    bool success = distMatrix != NULL && distFile != NULL;
+    for (int s = 0; success && s < graph.size; ++s) {
+        success = shortestPathTree(&fromMatrix, s, distMatrix, NULL) && shortestPathTree(&fromFile, s, distFile, NULL);
+        for (int v = 0; success && v < graph.size; ++v) {
+            if (!sameDistance(distMatrix[v], distFile[v]))
+                mismatch++;
+        }
+    }
+    free(distMatrix);
+    free(distFile);
+    freeAdjacency(&fromMatrix);
+    freeAdjacency(&fromFile);
+    printf("%s: neighbour lists read straight from the file, %d distances differ from the matrix\n", dataFiles.graph, mismatch);
+    if (!success || mismatch != 0)
+        return false;
+
+    const char *graphFile = "ingest_szak.txt", *placeFile = "ingest_csp.txt";
+    const int width = 1000, height = 1000;
+    int size = width * height;
+    printf("Writing %dx%d grid to %s and %s\n", width, height, graphFile, placeFile);
+    if (!writeIngestFiles(graphFile, placeFile, width, height)){
+        printf("Unable to write the files\n");
+        return false;
+    }
+
+    //Edges
+    Edge *reference;
+    Uint64 start = SDL_GetPerformanceCounter();
+    int count = referenceEdges(graphFile, size, &reference);
+    double referenceMs = elapsedMs(start);
+    Location *referencePlace = (Location*) calloc(size, sizeof(Location));
+    success = count >= 0 && referencePlace != NULL;
+    IngestReport report;
+    if (success){
+        EdgeList edges;
+        success = ingestEdges(graphFile, size, 1, &edges, &report);
+        if (success)
+            free(edges.values);
+        printIngestReport(graphFile, &report);
+        printf("%s: %.1f MB, %lld lines, %lld malformed\n", graphFile, report.bytes / 1048576.0, report.lines, report.malformed);
+        if (success && report.malformed != report.lines / 50000){
+            printf("%lld malformed lines were expected\n", report.lines / 50000);
+            success = false;
+        }
+        printf("Edges, fgets + sscanf: %9.1f ms %8.1f MB/s\n", referenceMs, megabytesPerSecond(report.bytes, referenceMs));
+    }
+    int cpus = SDL_GetCPUCount();
+    for (int threads = 1; success && threads <= cpus; threads = nextThreadCount(threads, cpus)) {
+        EdgeList edges;
+        start = SDL_GetPerformanceCounter();
+        success = ingestEdges(graphFile, size, threads, &edges, NULL);
+        double ms = elapsedMs(start);
+        if (success){
+            printf("Edges, %2d threads:     %9.1f ms %8.1f MB/s\n", threads, ms, megabytesPerSecond(report.bytes, ms));
+            if (!sameEdges(&edges, reference, count)){
+                printf("The edges differ from the reference\n");
+                success = false;
+            }
+            free(edges.values);
+        }
+    }
+    if (success){
+        //The neighbour lists keep the order of the lines, so they are the same with any number of threads
+        AdjacencyList adjacency, sequential;
+        EdgeList referenceList = {count, reference};
+        start = SDL_GetPerformanceCounter();
+        success = ingestGraph(graphFile, size, cpus, &adjacency, NULL);
+        double ms = elapsedMs(start);
+        if (success){
+            printf("Neighbour lists, %2d threads: %9.1f ms %8.1f MB/s\n", cpus, ms, megabytesPerSecond(report.bytes, ms));
+            success = edgesToAdjacency(&referenceList, size, 1, &sequential);
+            if (success){
+                int edges = adjacency.offsets[size];
+                success = edges == sequential.offsets[size]
+                          && memcmp(adjacency.offsets, sequential.offsets, (size + 1) * sizeof(int)) == 0
+                          && memcmp(adjacency.targets, sequential.targets, edges * sizeof(int)) == 0
+                          && memcmp(adjacency.weights, sequential.weights, edges * sizeof(double)) == 0;
+                if (!success)
+                    printf("The neighbour lists differ from the reference\n");
+                freeAdjacency(&sequential);
+            }
+            freeAdjacency(&adjacency);
+        }
+    }
+    free(reference);
+
+    //Places
+    if (success){
+        start = SDL_GetPerformanceCounter();
+        count = referencePlaces(placeFile, size, referencePlace);
+        referenceMs = elapsedMs(start);
+        success = count == size;
+    }
+    for (int threads = 1; success && threads <= cpus; threads = nextThreadCount(threads, cpus)) {
+        Position places;
+        start = SDL_GetPerformanceCounter();
+        success = ingestPlaces(placeFile, size, threads, &places, &report);
+        double ms = elapsedMs(start);
+        if (success){
+            if (threads == 1)
+                printf("Places, fgets + sscanf: %8.1f ms %8.1f MB/s\n", referenceMs, megabytesPerSecond(report.bytes, referenceMs));
+            printf("Places, %2d threads:    %9.1f ms %8.1f MB/s\n", threads, ms, megabytesPerSecond(report.bytes, ms));
+            success = places.size == size && report.malformed == 1;
+            for (int i = 0; success && i < size; ++i) {
+                success = places.values[i].x == referencePlace[i].x && places.values[i].y == referencePlace[i].y
+                          && strcmp(places.values[i].name, referencePlace[i].name) == 0;
+            }
+            if (!success)
+                printf("The places differ from the reference\n");
+            free(places.values);
+        }
+    }
+    free(referencePlace);
+    remove(graphFile);
+    remove(placeFile);
+    return success;
+}
+
+/*
+ * Runs the queries one by one, then in batches of 4, 8 and 16 sources on one thread
+ * @param adjacency is the graph
+ * @param name is printed before the results
+ * @param sources are the start points, sourceCount is a multiple of 16
+ * @return false if unable to allocate memory or the results differ
+ *
+ * @date 2026.10.19.
+ */
+static bool measureBatches(const AdjacencyList *adjacency, const char *name, const int *sources, int sourceCount){
+    int size = adjacency->size;
+    double *single = (double*) malloc((size_t) sourceCount * size * sizeof(double));
+    double *batched = (double*) malloc((size_t) MAX_BATCH * size * sizeof(double));
+    bool success = single != NULL && batched != NULL;
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int s = 0; s < sourceCount && success; ++s)
+        success = shortestPathTree(adjacency, sources[s], single + (size_t) s * size, NULL);
+    double singleMs = elapsedMs(start);
+    if (success)
+        printf("%s, %d queries one by one: %9.1f ms %8.1f queries/s\n", name, sourceCount, singleMs, sourceCount / (singleMs / 1000.0));
+
+    const int widths[] = {4, 8, 16};
+    for (int w = 0; w < 3 && success; ++w) {
+        int width = widths[w];
+        int mismatch = 0;
+        double ms = 0;
+        for (int first = 0; first < sourceCount && success; first += width) {
+            start = SDL_GetPerformanceCounter();
+            success = batchShortestPaths(adjacency, sources + first, width, batched);
+            ms += elapsedMs(start);
+            for (size_t i = 0; success && i < (size_t) width * size; ++i) {
+                if (!sameDistance(batched[i], single[(size_t) first * size + i]))
+                    mismatch++;
+            }
+        }
+        if (success)
+            printf("%s, batches of %2d:           %9.1f ms %8.1f queries/s %5.2fx, %d mismatches\n", name, width, ms,
+                   sourceCount / (ms / 1000.0), singleMs / ms, mismatch);
+        success = success && mismatch == 0;
+    }
+    free(single);
+    free(batched);
+    return success;
+}
+
+/*
+ * Batched multi-source search (batchShortestPaths) compared to shortestPathTree per source
+ *
+ * @date 2026.10.19.
+ */
+static bool benchmarkBatchSearch(const Graph graph, const Position position){
+    (void) position;
+    const int sourceCount = 64;
+    int sources[sourceCount];
+    AdjacencyList adjacency;
+    if (!buildAdjacency(graph, &adjacency))
+        return false;
+    srand(2019);
+    for (int i = 0; i < sourceCount; ++i)
+        sources[i] = rand() % graph.size;
+    bool success = measureBatches(&adjacency, "Bundled graph", sources, sourceCount);
+    freeAdjacency(&adjacency);
+
+    /*
+     * The batches pay off when their sources are close to each other, then the lanes of a vertex
+     * improve at about the same time. Far sources make the vertexes taken out of the heap once per lane.
+     */
+    const int width = 400, height = 400;
+    if (success && buildGridGraph(width, height, &adjacency)){
+        //Groups of 16 sources: 4x4 vertexes 3 apart around a random point
+        for (int i = 0; i < sourceCount; i += 16) {
+            int corner = (rand() % (height - 12)) * width + rand() % (width - 12);
+            for (int j = 0; j < 16; ++j)
+                sources[i + j] = corner + (j / 4) * 3 * width + (j % 4) * 3;
+        }
+        success = measureBatches(&adjacency, "400x400 grid, near sources", sources, sourceCount);
+        for (int i = 0; i < sourceCount; ++i)
+            sources[i] = rand() % adjacency.size;
+        success = success && measureBatches(&adjacency, "400x400 grid, far sources ", sources, sourceCount);
+        freeAdjacency(&adjacency);
+    } else
+        success = false;
+    return success;
+}
+
+/*
+ * A leg in the format of dijkstraAlgorithm from a shortest path tree: the vertexes in reversed order, -1 at the end
+ * @param prev is the tree of from
+ * @param route gets the leg, it has room for every vertex and the -1
+ *
+ * @date 2026.10.19.
+ */
+static void routeFromTree(const int *prev, int from, int to, int *route){
+    int length = 0;
+    if (prev[to] != -1){
+        for (int vertex = to; vertex != from; vertex = prev[vertex])
+            route[length++] = vertex;
+        route[length++] = from;
+    }
+    route[length] = -1;
+}
+
+/*
+ * Writes random routes with 1 to 3 legs through the places of the bundled graph, the second leg of every
+ * 10th route has no connection, so with a third leg its geometry has two parts. The first leg of every other
+ * 10th route stays at its place and the second one has no connection, so its single point has to be left out.
+ * @param trees are the shortest path trees of every vertex, dists are their distances
+ * @return false if the file cannot be written
+ *
+ * @date 2026.10.19.
+ */
+static bool writeRandomRoutes(const char *filename, const Position position, const int *trees, const double *dists,
+                              int routes, int *route){
+    int size = position.size;
+    RouteWriter writer;
+    if (!openRouteWriter(&writer, filename, routeFormatOf(filename)))
+        return false;
+    srand(2019);
+    Uint64 start = SDL_GetPerformanceCounter();
+    bool success = true;
+    for (int r = 0; r < routes && success; ++r) {
+        beginRoute(&writer);
+        int from = rand() % size;
+        int legs = rand() % 3 + 1;
+        for (int leg = 0; leg < legs && success; ++leg) {
+            //The chosen places of a leg differ, as in the UI
+            int to;
+            do {
+                to = rand() % size;
+            } while (to == from && size > 1);
+            if (r % 10 == 4 && leg == 0){
+                to = from;
+                route[0] = from;
+                route[1] = -1;
+            } else
+                routeFromTree(trees + (size_t) from * size, from, to, route);
+            if ((r % 10 == 9 || r % 10 == 4) && leg == 1)
+                route[0] = -1;
+            success = addRouteLeg(&writer, position, from, to, route, dists[(size_t) from * size + to]);
+            from = to;
+        }
+        success = success && endRoute(&writer, position);
+    }
+    size_t memory = writer.head.capacity + writer.points.capacity + writer.partCapacity * sizeof(uint32_t)
+                    + writer.legCapacity * sizeof(RouteLegInfo);
+    long long bytes = writer.bytes;
+    success = closeRouteWriter(&writer) && success;
+    double ms = elapsedMs(start);
+    if (success)
+        printf("%-20s %d routes: %8.1f ms %9.0f routes/s %7.1f MB/s, %.1f MB file, %zu bytes of route buffers\n", filename,
+               routes, ms, routes / (ms / 1000.0), megabytesPerSecond(bytes, ms), bytes / 1048576.0, memory);
+    return success;
+}
+
+/*
+ * Checks a record of the binary route file: the parts have to cover the points, and the sizes have to add
+ * up to the length of the record
+ * @param record is the record after its length
+ *
+ * @date 2026.10.19.
+ */
+static bool validRouteRecord(const char *record, uint32_t length){
+    uint32_t legs, points, parts;
+    if (length < 20)
+        return false;
+    memcpy(&legs, record, 4);
+    memcpy(&points, record + 4, 4);
+    memcpy(&parts, record + 8, 4);
+    if (legs < 1 || legs > 3 || parts > legs || (points > 0) != (parts > 0))
+        return false;
+    size_t offset = 20 + (size_t) legs * 16;
+    for (uint32_t i = 0; i <= legs && offset < length; ++i)
+        offset += 1 + (uint8_t) record[offset];
+    uint32_t covered = 0;
+    for (uint32_t i = 0; i < parts && offset + 4 <= length; ++i, offset += 4) {
+        uint32_t partPoints;
+        memcpy(&partPoints, record + offset, 4);
+        if (partPoints < 2)
+            return false;
+        covered += partPoints;
+    }
+    return covered == points && offset + (size_t) points * 20 == length;
+}
+
+/*
+ * Reads the binary route file back record by record
+ * @param multipart gets the number of the routes with more than one part
+ * @return the number of records, -1 if the file is not valid
+ *
+ * @date 2026.10.19.
+ */
+static long long countRouteRecords(const char *filename, long long *multipart){
+    FILE *fp = fopen(filename, "rb");
+    if (fp == NULL)
+        return -1;
+    char magic[4];
+    uint32_t version, length;
+    long long records = 0;
+    char *record = NULL;
+    *multipart = 0;
+    if (fread(magic, 1, 4, fp) != 4 || memcmp(magic, "RPRT", 4) != 0 || fread(&version, sizeof(version), 1, fp) != 1
+        || version != 2)
+        records = -1;
+    while (records >= 0 && fread(&length, sizeof(length), 1, fp) == 1){
+        char *temp = (char*) realloc(record, length > 0 ? length : 1);
+        if (temp == NULL || fread(temp, 1, length, fp) != length || !validRouteRecord(temp, length)){
+            if (temp != NULL)
+                record = temp;
+            records = -1;
+            break;
+        }
+        record = temp;
+        uint32_t parts;
+        memcpy(&parts, record + 8, 4);
+        if (parts > 1)
+            (*multipart)++;
+        records++;
+    }
+    free(record);
+    fclose(fp);
+    return records;
+}
+
+/*
+ * Counts the lines of a GeoJSON route file with a single point: "[[x,y]]"
+ * @return the number of them, -1 if the file cannot be read
+ *
+ * @date 2026.10.19.
+ */
+static long long countLonePoints(const char *filename){
+    FILE *fp = fopen(filename, "rb");
+    if (fp == NULL)
+        return -1;
+    long long count = 0;
+    int previous = EOF, c;
+    bool inPoint = false;
+    //After "[[" the first ']' closes the first point, a second ']' right after it closes the line
+    while ((c = fgetc(fp)) != EOF){
+        if (c == '[' && previous == '[')
+            inPoint = true;
+        else if (c == ']' && inPoint){
+            inPoint = false;
+            c = fgetc(fp);
+            if (c == ']')
+                count++;
+        }
+        previous = c;
+    }
+    fclose(fp);
+    return count;
+}
+
+/*
+ * Streaming random routes to GeoJSON and to the binary format, the original coordinates are checked against csp.txt
+ *
+ * @date 2026.10.19.
+ */
+static bool benchmarkRouteWriter(const Graph graph, const Position position){
+    //originalCoordinates has to give back the coordinates of csp.txt
+    Position raw;
+    if (!ingestPlaces(dataFiles.places, dataFiles.maxPlaces, 1, &raw, NULL))
+        return false;
+    int mismatch = 0;
+    for (int i = 0; i < position.size && i < raw.size; ++i) {
+        double x, y;
+        originalCoordinates(position.values[i], &x, &y);
+        if (fabs(x - raw.values[i].x) > 1e-6 || fabs(y - raw.values[i].y) > 1e-6)
+            mismatch++;
+    }
+    free(raw.values);
+    printf("%d places with original coordinates different from %s\n", mismatch, dataFiles.places);
+    if (mismatch != 0)
+        return false;
+
+    //The graph is loaded as in the window, the legs of the planner have to be the same as the ones of dijkstraAlgorithm
+    int size = graph.size;
+    AdjacencyList adjacency;
+    if (!readAdjacency(&adjacency, size, dataFiles.graph))
+        return false;
+    int *trees = (int*) malloc((size_t) size * size * sizeof(int));
+    double *dists = (double*) malloc((size_t) size * size * sizeof(double));
+    int *route = (int*) malloc((size + 1) * sizeof(int));
+    bool success = trees != NULL && dists != NULL && route != NULL;
+    for (int s = 0; s < size && success; ++s)
+        success = shortestPathTree(&adjacency, s, dists + (size_t) s * size, trees + (size_t) s * size);
+    for (int i = 0; i < 1000 && success; ++i) {
+        int from = rand() % size, to = rand() % size;
+        double distance = 0, length = 0;
+        int *planned = dijkstraAlgorithm(graph, from, to, &distance);
+        int *leg = shortestRoute(&adjacency, from, to, &length);
+        success = planned != NULL && leg != NULL;
+        if (success && ((planned[0] == -1) != (leg[0] == -1) || (leg[0] != -1
+            && (!sameDistance(distance, length) || !sameDistance(length, dists[(size_t) from * size + to]) || leg[0] != to))))
+            mismatch++;
+        free(planned);
+        free(leg);
+    }
+    freeAdjacency(&adjacency);
+    printf("%d legs of shortestRoute different from dijkstraAlgorithm\n", mismatch);
+
+    const int routes = 200000;
+    const char *geoJson = "routes_bench.geojson", *binary = "routes_bench.bin";
+    success = success && mismatch == 0 && writeRandomRoutes(geoJson, position, trees, dists, routes, route)
+              && writeRandomRoutes(binary, position, trees, dists, routes, route);
+    if (success){
+        long long multipart = 0;
+        long long records = countRouteRecords(binary, &multipart);
+        long long lonePoints = countLonePoints(geoJson);
+        printf("%s: %lld records read back, %lld of them in more parts\n", binary, records, multipart);
+        printf("%s: %lld lines with a single point\n", geoJson, lonePoints);
+        success = records == routes && multipart > 0 && lonePoints == 0;
+    }
+    free(trees);
+    free(dists);
+    free(route);
+    remove(geoJson);
+    remove(binary);
+    return success;
+}
+
+typedef struct{
+    const char *name;
+    bool (*run)(const Graph graph, const Position position);
+}Benchmark;
+
+
+static const Benchmark benchmarks[] = {
+    {"matrix", benchmarkDistanceMatrix},
+    {"hublabels", benchmarkHubLabels},
+    {"deltastep", benchmarkDeltaStepping},
+    {"isochrone", benchmarkIsochrones},
+    {"alternatives", benchmarkAlternatives},
+    {"placeindex", benchmarkPlaceIndex},
+    {"compact", benchmarkCompactGraph},
+    {"ingest", benchmarkIngest},
+    {"batch", benchmarkBatchSearch},
+    {"routes", benchmarkRouteWriter},
+};
+
+/*
+ * Runs a benchmark and prints its results to the standard output
+ * @param name is the name of the benchmark, the list of them is printed if it is unknown
+ * @param graph and position are the loaded data
+ * @param files are the paths of the loaded data
+ * @return false if the benchmark is unknown, it failed or its results are wrong
+ *
+ * @date 2026.10.19.
+ */
+bool runBenchmark(const char *name, const Graph graph, const Position position, const DataFiles files){
+    dataFiles = files;
+    int count = sizeof(benchmarks) / sizeof(benchmarks[0]);
+    for (int i = 0; i < count; ++i) {
+        if (strcmp(name, benchmarks[i].name) == 0)
+            return benchmarks[i].run(graph, position);
+    }
+    printf("Unknown benchmark: %s\nAvailable:", name);
+    for (int i = 0; i < count; ++i)
+        printf(" %s", benchmarks[i].name);
+    printf("\n");
+    return false;
+}
@@ -0,0 +1,14 @@
+//
+// Created by Mark on 10/19/2026
+//
+
+#include <stdbool.h>
+#include "managefile.h"
+#include "managegraph.h"
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+bool runBenchmark(const char *name, const Graph graph, const Position position, const DataFiles files);
+
+#endif //BENCHMARK_H
@@ -0,0 +1,274 @@
+//
+// Created by Mark on 10/19/2026
+//
+// Compressed graph with varint neighbour lists, fixed-point weights and quantized coordinates
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+
+#include "compactgraph.h"
+#include "managefile.h"
+#include "managegraph.h"
+#include "minheap.h"
+#include "../debugmalloc.h"
+
+#define WEIGHT_SCALE 100.0  //fixed-point units in a km
+
+typedef struct{
+    int target;
+    uint32_t weight;
+}CompactEdge;
+
+static int compareEdges(const void *a, const void *b){
+    return ((const CompactEdge*) a)->target - ((const CompactEdge*) b)->target;
+}
+
+/*
+ * Writes a number as a varint: 7 bits in a byte, the highest bit signs that more bytes follow
+ * @return the number of bytes written (at most 5)
+ */
+static int writeVarint(uint8_t *data, uint32_t value){
+    int count = 0;
+    while (value >= 0x80){
+        data[count++] = (uint8_t) (value | 0x80);
+        value >>= 7;
+    }
+    data[count++] = (uint8_t) value;
+    return count;
+}
+
+static uint32_t readVarint(const uint8_t **data){
+    uint32_t value = 0;
+    int shift = 0;
+    const uint8_t *p = *data;
+    while (*p & 0x80){
+        value |= (uint32_t) (*p++ & 0x7F) << shift;
+        shift += 7;
+    }
+    value |= (uint32_t) *p++ << shift;
+    *data = p;
+    return value;
+}
+
+//The first target is stored relative to the vertex itself, so it can be negative: zigzag encoding
+static uint32_t zigzag(int value){
+    return ((uint32_t) value << 1) ^ (uint32_t) (value >> 31);
+}
+
+static int unzigzag(uint32_t value){
+    return (int) (value >> 1) ^ -(int) (value & 1);
+}
+
+/*
+ * Quantizes the coordinates and copies the names of the places. The empty slots are left out of the
+ * bounding box, they are decoded as an empty Location.
+ * @return false if unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+static bool compactPlaces(const Position *position, CompactGraph *compact){
+    int size = compact->size;
+    compact->x = (uint16_t*) malloc(size * sizeof(uint16_t));
+    compact->y = (uint16_t*) malloc(size * sizeof(uint16_t));
+    compact->nameAt = (uint32_t*) malloc((size + 1) * sizeof(uint32_t));
+    size_t length = 0;
+    for (int i = 0; i < size; ++i)
+        length += strlen(position->values[i].name) + 1;
+    compact->names = (char*) malloc(length > 0 ? length : 1);
+    compact->placed = (uint8_t*) calloc(size / 8 + 1, 1);
+    if (compact->x == NULL || compact->y == NULL || compact->nameAt == NULL || compact->names == NULL || compact->placed == NULL)
+        return false;
+
+    double maxX = -DBL_MAX, maxY = -DBL_MAX;
+    compact->minX = DBL_MAX;
+    compact->minY = DBL_MAX;
+    for (int i = 0; i < size; ++i) {
+        //The place numbers of csp.txt start from 1, the missing ones are not real places
+        if (position->values[i].num != i + 1)
+            continue;
+        compact->placed[i / 8] |= (uint8_t) (1 << (i % 8));
+        compact->minX = fmin(compact->minX, position->values[i].x);
+        compact->minY = fmin(compact->minY, position->values[i].y);
+        maxX = fmax(maxX, position->values[i].x);
+        maxY = fmax(maxY, position->values[i].y);
+    }
+    if (compact->minX > maxX){
+        compact->minX = maxX = 0;
+        compact->minY = maxY = 0;
+    }
+    compact->stepX = maxX > compact->minX ? (maxX - compact->minX) / 65535 : 1;
+    compact->stepY = maxY > compact->minY ? (maxY - compact->minY) / 65535 : 1;
+
+    uint32_t at = 0;
+    for (int i = 0; i < size; ++i) {
+        bool placed = compact->placed[i / 8] & (1 << (i % 8));
+        compact->x[i] = placed ? (uint16_t) lround((position->values[i].x - compact->minX) / compact->stepX) : 0;
+        compact->y[i] = placed ? (uint16_t) lround((position->values[i].y - compact->minY) / compact->stepY) : 0;
+        compact->nameAt[i] = at;
+        strcpy(compact->names + at, position->values[i].name);
+        at += (uint32_t) strlen(position->values[i].name) + 1;
+    }
+    compact->nameAt[size] = at;
+    return true;
+}
+
+/*
+ * Builds the compact form of the graph
+ * @param adjacency is the graph as neighbour lists, the weights are rounded to 10 m
+ * @param position is the vertex array, or NULL if only the edges are needed
+ * @param compact is where the compact graph is built, free it with freeCompactGraph
+ * @return false if unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+bool buildCompactGraph(const AdjacencyList *adjacency, const Position *position, CompactGraph *compact){
+    int size = adjacency->size;
+    memset(compact, 0, sizeof(CompactGraph));
+    compact->size = size;
+    int maxDegree = 0;
+    for (int i = 0; i < size; ++i) {
+        if (adjacency->offsets[i+1] - adjacency->offsets[i] > maxDegree)
+            maxDegree = adjacency->offsets[i+1] - adjacency->offsets[i];
+    }
+    //At most 5 bytes for a target and 5 for a weight, the buffer is shrunk at the end
+    size_t capacity = (size_t) adjacency->offsets[size] * 10;
+    compact->offsets = (uint32_t*) malloc((size + 1) * sizeof(uint32_t));
+    compact->edges = (uint8_t*) malloc(capacity > 0 ? capacity : 1);
+    CompactEdge *list = (CompactEdge*) malloc((maxDegree > 0 ? maxDegree : 1) * sizeof(CompactEdge));
+    if (compact->offsets == NULL || compact->edges == NULL || list == NULL){
+        free(list);
+        freeCompactGraph(compact);
+        return false;
+    }
+
+    uint32_t at = 0;
+    for (int v = 0; v < size; ++v) {
+        compact->offsets[v] = at;
+        int degree = adjacency->offsets[v+1] - adjacency->offsets[v];
+        for (int i = 0; i < degree; ++i) {
+            list[i].target = adjacency->targets[adjacency->offsets[v] + i];
+            list[i].weight = (uint32_t) lround(adjacency->weights[adjacency->offsets[v] + i] * WEIGHT_SCALE);
+        }
+        qsort(list, degree, sizeof(CompactEdge), compareEdges);
+        int previous = v;
+        for (int i = 0; i < degree; ++i) {
+            if (i == 0)
+                at += writeVarint(compact->edges + at, zigzag(list[i].target - v));
+            else
+                at += writeVarint(compact->edges + at, (uint32_t) (list[i].target - previous));
+            previous = list[i].target;
+            at += writeVarint(compact->edges + at, list[i].weight);
+        }
+    }
+    compact->offsets[size] = at;
+    free(list);
+    uint8_t *temp = (uint8_t*) realloc(compact->edges, at > 0 ? at : 1);
+    if (temp != NULL)
+        compact->edges = temp;
+
+    if (position != NULL && !compactPlaces(position, compact)){
+        freeCompactGraph(compact);
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Dijkstra algorithm from one vertex to all the others, the neighbour lists are decoded while searching
+ * @param compact is the compact graph
+ * @param startPoint of the search
+ * @param dist is an array of compact->size, the shortest distances are placed here in km (DBL_MAX: unreachable)
+ * @return false if unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+bool compactShortestPathTree(const CompactGraph *compact, int startPoint, double *dist){
+    //The distances are summed in fixed-point, so they are exact
+    uint64_t *units = (uint64_t*) malloc(compact->size * sizeof(uint64_t));
+    MinHeap heap;
+    if (units == NULL || !initHeap(&heap, compact->size)){
+        free(units);
+        return false;
+    }
+    for (int i = 0; i < compact->size; ++i)
+        units[i] = UINT64_MAX;
+    units[startPoint] = 0;
+    pushHeap(&heap, 0, startPoint);
+    bool success = true;
+    while (heap.size > 0 && success){
+        HeapItem item = popHeap(&heap);
+        if ((uint64_t) item.key > units[item.vertex])
+            continue;
+        const uint8_t *p = compact->edges + compact->offsets[item.vertex];
+        const uint8_t *end = compact->edges + compact->offsets[item.vertex + 1];
+        int target = item.vertex;
+        bool first = true;
+        while (p < end){
+            if (first)
+                target = item.vertex + unzigzag(readVarint(&p));
+            else
+                target += (int) readVarint(&p);
+            first = false;
+            uint64_t weight = units[item.vertex] + readVarint(&p);
+            if (weight < units[target]){
+                units[target] = weight;
+                if (!pushHeap(&heap, (double) weight, target))
+                    success = false;
+            }
+        }
+    }
+    for (int i = 0; i < compact->size; ++i)
+        dist[i] = units[i] == UINT64_MAX ? DBL_MAX : (double) units[i] / WEIGHT_SCALE;
+    free(units);
+    freeHeap(&heap);
+    return success;
+}
+
+/*
+ * Decodes a place of the compact graph
+ * @param compact is the compact graph built with places
+ * @param vertex is the place
+ * @param place gets the number, the coordinates (within the quantization step) and the name (at most 50 bytes),
+ *        an empty slot gets num 0 and zero coordinates
+ *
+ * @date 2026.10.19.
+ */
+void compactLocation(const CompactGraph *compact, int vertex, Location *place){
+    if (!(compact->placed[vertex / 8] & (1 << (vertex % 8)))){
+        memset(place, 0, sizeof(Location));
+        return;
+    }
+    place->num = vertex + 1;
+    place->x = compact->minX + compact->x[vertex] * compact->stepX;
+    place->y = compact->minY + compact->y[vertex] * compact->stepY;
+    strncpy(place->name, compact->names + compact->nameAt[vertex], sizeof(place->name) - 1);
+    place->name[sizeof(place->name) - 1] = '\0';
+}
+
+/*
+ * @return the memory used by the compact graph in bytes
+ *
+ * @date 2026.10.19.
+ */
+size_t compactGraphSize(const CompactGraph *compact){
+    size_t size = sizeof(CompactGraph) + (compact->size + 1) * sizeof(uint32_t) + compact->offsets[compact->size];
+    if (compact->x != NULL)
+        size += 2 * compact->size * sizeof(uint16_t) + (compact->size + 1) * sizeof(uint32_t) + compact->nameAt[compact->size]
+                + compact->size / 8 + 1;
+    return size;
+}
+
+void freeCompactGraph(CompactGraph *compact){
+    free(compact->offsets);
+    free(compact->edges);
+    free(compact->x);
+    free(compact->y);
+    free(compact->nameAt);
+    free(compact->placed);
+    free(compact->names);
+    memset(compact, 0, sizeof(CompactGraph));
+}
@@ -0,0 +1,39 @@
+//
+// Created by Mark on 10/19/2026
+//
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "managefile.h"
+#include "managegraph.h"
+
+#ifndef COMPACTGRAPH_H
+#define COMPACTGRAPH_H
+
+/*
+ * Memory saving form of the graph and the places for large networks.
+ *  - edges: the neighbour list of each vertex is a byte stream of varints, the targets are sorted and stored as
+ *    differences, the weights are fixed-point numbers in 10 m units (szak.txt has two decimals, so they are exact)
+ *  - coordinates: 16 bit steps inside the bounding box of the places
+ *  - names: one string table without the unused bytes of Location.name
+ *  - empty slots (no place with that number in csp.txt): one bit per vertex, they keep num 0
+ */
+typedef struct{
+    int size;
+    uint32_t *offsets;  //where the neighbour list of a vertex begins in edges
+    uint8_t *edges;
+    uint16_t *x, *y;    //NULL if the graph was built without places
+    double minX, minY, stepX, stepY;
+    uint32_t *nameAt;   //where the name of a vertex begins in names
+    char *names;
+    uint8_t *placed;    //bit i is set if vertex i is a real place
+}CompactGraph;
+
+bool buildCompactGraph(const AdjacencyList *adjacency, const Position *position, CompactGraph *compact);
+bool compactShortestPathTree(const CompactGraph *compact, int startPoint, double *dist);
+void compactLocation(const CompactGraph *compact, int vertex, Location *place);
+size_t compactGraphSize(const CompactGraph *compact);
+void freeCompactGraph(CompactGraph *compact);
+
+#endif //COMPACTGRAPH_H
@@ -0,0 +1,485 @@
+//
+// Created by Mark on 10/19/2026
+//
+// Parallel single source shortest paths with the delta-stepping algorithm
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <float.h>
+#include <SDL2/SDL.h>
+
+#include "deltastep.h"
+#include "managegraph.h"
+#include "../debugmalloc.h"
+
+/*
+ * Delta-stepping: the tentative distances are put into buckets of width delta, and the buckets are
+ * processed in increasing order. Inside a bucket the light edges (weight <= delta) are relaxed again and
+ * again while the bucket gets new vertexes, then the heavy edges of all the removed vertexes are relaxed once.
+ * The vertexes of a bucket can be processed at the same time, that is where the threads come in.
+ *
+ * Every vertex has an owner thread (vertex % threads), only the owner writes the distance and the buckets
+ * of a vertex. A step has two halves separated by a barrier:
+ *  - relaxing: every thread takes chunks of its own part of the frontier, then steals chunks from the parts
+ *    of the others, so a thread with cheap vertexes takes more chunks. The improved distances are sent to
+ *    the owners as requests.
+ *  - applying: every owner applies the requests sent to it.
+ * Therefore no locks or atomic operations are needed on the distances.
+ *
+ * The parts of the frontier are only read while relaxing, so instead of deques with an owner end and a
+ * stealing end, a part is a list with an atomic counter of the taken chunks. The owner and the thieves take
+ * chunks from the front with one atomic addition, a compare-and-swap loop is never needed.
+ */
+
+#define CHUNK 256           //vertexes of the frontier taken at once
+#define BARRIER_SPIN 4000   //checks before a thread goes to sleep at the barrier
+
+typedef struct{
+    int vertex;
+    double dist;
+}Request;
+
+typedef struct{
+    int size, capacity;
+    int *items;
+}IntVector;
+
+typedef struct{
+    int size, capacity;
+    Request *items;
+}RequestVector;
+
+typedef enum{
+    STEP_EXTRACT,   //the owners take the vertexes of the current bucket into the frontier
+    STEP_LIGHT,     //relaxing the light edges of the frontier
+    STEP_HEAVY,     //relaxing the heavy edges of the vertexes removed from the current bucket
+    STEP_DONE
+}Step;
+
+typedef struct{
+    IntVector *buckets;     //cyclic array of bucketCount buckets
+    IntVector frontier, next, settled;
+    RequestVector *outbox;  //requests sent to the owners, one vector for each
+    SDL_atomic_t taken;     //the vertexes of the relaxed list taken by the threads so far
+}Owner;
+
+typedef struct{
+    SDL_atomic_t count;     //atomic, because it is lowered when not all the threads could be started
+    SDL_atomic_t waiting, generation;
+    SDL_mutex *mutex;
+    SDL_cond *cond;
+}Barrier;
+
+typedef struct{
+    const AdjacencyList *adjacency;
+    double delta;
+    int threads, bucketCount;
+    double *dist;
+    int *mark;          //the round in which the vertex was put into the frontier
+    int *settledMark;   //the bucket from which the vertex was removed last
+    Owner *owners;
+    Step step;
+    int current, round;
+    SDL_atomic_t failed;
+    Barrier barrier;
+}DeltaJob;
+
+typedef struct{
+    DeltaJob *job;
+    int id;
+}Worker;
+
+static bool pushInt(IntVector *vector, int item){
+    if (vector->size == vector->capacity){
+        int capacity = vector->capacity == 0 ? 16 : 2 * vector->capacity;
+        int *temp = (int*) realloc(vector->items, capacity * sizeof(int));
+        if (temp == NULL)
+            return false;
+        vector->items = temp;
+        vector->capacity = capacity;
+    }
+    vector->items[vector->size++] = item;
+    return true;
+}
+
+static bool pushRequest(RequestVector *vector, int vertex, double dist){
+    if (vector->size == vector->capacity){
+        int capacity = vector->capacity == 0 ? 16 : 2 * vector->capacity;
+        Request *temp = (Request*) realloc(vector->items, capacity * sizeof(Request));
+        if (temp == NULL)
+            return false;
+        vector->items = temp;
+        vector->capacity = capacity;
+    }
+    vector->items[vector->size].vertex = vertex;
+    vector->items[vector->size].dist = dist;
+    vector->size++;
+    return true;
+}
+
+/*
+ * Waits until all the threads arrive. The threads spin for a while, because the steps are usually short,
+ * then they go to sleep, so that more threads than CPUs do not burn the time of each other.
+ *
+ * @date 2026.10.19.
+ */
+static void waitBarrier(Barrier *barrier){
+    int generation = SDL_AtomicGet(&barrier->generation);
+    //The count is read after arriving: a lowered count is set before the lowering thread arrives
+    int arrived = SDL_AtomicAdd(&barrier->waiting, 1);
+    if (arrived == SDL_AtomicGet(&barrier->count) - 1){
+        SDL_AtomicSet(&barrier->waiting, 0);
+        SDL_LockMutex(barrier->mutex);
+        SDL_AtomicAdd(&barrier->generation, 1);
+        SDL_CondBroadcast(barrier->cond);
+        SDL_UnlockMutex(barrier->mutex);
+        return;
+    }
+    for (int spin = 0; spin < BARRIER_SPIN; ++spin) {
+        if (SDL_AtomicGet(&barrier->generation) != generation)
+            return;
+    }
+    SDL_LockMutex(barrier->mutex);
+    while (SDL_AtomicGet(&barrier->generation) == generation)
+        SDL_CondWait(barrier->cond, barrier->mutex);
+    SDL_UnlockMutex(barrier->mutex);
+}
+
+static int bucketOf(const DeltaJob *job, double dist){
+    return (int) (dist / job->delta);
+}
+
+/*
+ * Resets the taken counters of the owners' frontier or settled list before relaxing them
+ * @return the size of the whole list
+ *
+ * @date 2026.10.19.
+ */
+static int prepareList(DeltaJob *job, bool frontier){
+    int total = 0;
+    for (int i = 0; i < job->threads; ++i) {
+        total += frontier ? job->owners[i].frontier.size : job->owners[i].settled.size;
+        SDL_AtomicSet(&job->owners[i].taken, 0);
+    }
+    return total;
+}
+
+/*
+ * Moves the current bucket forward to the next one which has vertexes in it
+ * @return false if all the buckets are empty
+ *
+ * @date 2026.10.19.
+ */
+static bool nextBucket(DeltaJob *job){
+    for (int k = 1; k <= job->bucketCount; ++k) {
+        int slot = (job->current + k) % job->bucketCount;
+        for (int i = 0; i < job->threads; ++i) {
+            if (job->owners[i].buckets[slot].size > 0){
+                job->current += k;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/*
+ * Chooses the next step, only thread 0 runs it while the others wait at the barrier
+ *
+ * @date 2026.10.19.
+ */
+static void decideStep(DeltaJob *job){
+    if (SDL_AtomicGet(&job->failed)){
+        job->step = STEP_DONE;
+        return;
+    }
+    switch (job->step){
+    case STEP_EXTRACT:
+    case STEP_LIGHT:
+        if (prepareList(job, true) > 0){
+            job->step = STEP_LIGHT;
+            job->round++;
+        } else if (job->step == STEP_LIGHT){
+            prepareList(job, false);
+            job->step = STEP_HEAVY;
+        } else if (nextBucket(job)){
+            job->step = STEP_EXTRACT;
+            job->round++;
+        } else
+            job->step = STEP_DONE;
+        break;
+    case STEP_HEAVY:
+        if (nextBucket(job)){
+            job->step = STEP_EXTRACT;
+            job->round++;
+        } else
+            job->step = STEP_DONE;
+        break;
+    case STEP_DONE:
+        break;
+    }
+}
+
+/*
+ * The owner takes the valid vertexes of the current bucket into its frontier. The vertexes which got into
+ * a smaller bucket since then, and the repeated ones are left out.
+ *
+ * @date 2026.10.19.
+ */
+static void extractBucket(DeltaJob *job, int id){
+    Owner *owner = &job->owners[id];
+    IntVector *bucket = &owner->buckets[job->current % job->bucketCount];
+    for (int i = 0; i < bucket->size; ++i) {
+        int vertex = bucket->items[i];
+        if (bucketOf(job, job->dist[vertex]) == job->current && job->mark[vertex] != job->round){
+            job->mark[vertex] = job->round;
+            if (!pushInt(&owner->frontier, vertex))
+                SDL_AtomicSet(&job->failed, 1);
+        }
+    }
+    bucket->size = 0;
+}
+
+/*
+ * Relaxes the light or the heavy edges of a chunk of vertexes, the better distances are sent to the owners
+ *
+ * @date 2026.10.19.
+ */
+static void relaxChunk(DeltaJob *job, Owner *self, const int *vertexes, int count, bool light){
+    const AdjacencyList *adjacency = job->adjacency;
+    for (int i = 0; i < count; ++i) {
+        int vertex = vertexes[i];
+        double dist = job->dist[vertex];
+        for (int e = adjacency->offsets[vertex]; e < adjacency->offsets[vertex + 1]; ++e) {
+            double weight = adjacency->weights[e];
+            if ((weight <= job->delta) != light)
+                continue;
+            int next = adjacency->targets[e];
+            if (dist + weight < job->dist[next]){
+                if (!pushRequest(&self->outbox[next % job->threads], next, dist + weight))
+                    SDL_AtomicSet(&job->failed, 1);
+            }
+        }
+    }
+}
+
+/*
+ * Relaxes the light or the heavy edges of the chunks taken by the thread, the better distances are sent
+ * to the owners of the vertexes. The thread starts with its own part, then steals from the next ones.
+ *
+ * @date 2026.10.19.
+ */
+static void relaxEdges(DeltaJob *job, int id, bool light){
+    Owner *self = &job->owners[id];
+    for (int k = 0; k < job->threads; ++k) {
+        Owner *victim = &job->owners[(id + k) % job->threads];
+        const IntVector *list = light ? &victim->frontier : &victim->settled;
+        int begin;
+        while ((begin = SDL_AtomicAdd(&victim->taken, CHUNK)) < list->size){
+            int end = begin + CHUNK < list->size ? begin + CHUNK : list->size;
+            relaxChunk(job, self, list->items + begin, end - begin, light);
+        }
+    }
+}
+
+/*
+ * The owner applies the requests sent to it. In the light step the vertexes staying in the current bucket
+ * become the next frontier, the others go into their bucket.
+ *
+ * @date 2026.10.19.
+ */
+static void applyRequests(DeltaJob *job, int id, bool light){
+    Owner *owner = &job->owners[id];
+    for (int s = 0; s < job->threads; ++s) {
+        RequestVector *requests = &job->owners[s].outbox[id];
+        for (int i = 0; i < requests->size; ++i) {
+            int vertex = requests->items[i].vertex;
+            double dist = requests->items[i].dist;
+            if (dist >= job->dist[vertex])
+                continue;
+            job->dist[vertex] = dist;
+            int bucket = bucketOf(job, dist);
+            bool success;
+            if (light && bucket == job->current){
+                //round+1 is the round of the next light step
+                if (job->mark[vertex] == job->round + 1)
+                    continue;
+                job->mark[vertex] = job->round + 1;
+                success = pushInt(&owner->next, vertex);
+            } else
+                success = pushInt(&owner->buckets[bucket % job->bucketCount], vertex);
+            if (!success)
+                SDL_AtomicSet(&job->failed, 1);
+        }
+        requests->size = 0;
+    }
+    if (light){
+        //The processed frontier is removed from the bucket, its heavy edges are relaxed at the end
+        for (int i = 0; i < owner->frontier.size; ++i) {
+            int vertex = owner->frontier.items[i];
+            if (job->settledMark[vertex] != job->current){
+                job->settledMark[vertex] = job->current;
+                if (!pushInt(&owner->settled, vertex))
+                    SDL_AtomicSet(&job->failed, 1);
+            }
+        }
+        IntVector temp = owner->frontier;
+        owner->frontier = owner->next;
+        owner->next = temp;
+        owner->next.size = 0;
+    } else
+        owner->settled.size = 0;
+}
+
+static int deltaThread(void *data){
+    Worker *worker = (Worker*) data;
+    DeltaJob *job = worker->job;
+    int id = worker->id;
+    for (;;){
+        if (id == 0)
+            decideStep(job);
+        waitBarrier(&job->barrier);
+        Step step = job->step;
+        if (step == STEP_DONE)
+            break;
+        if (step == STEP_EXTRACT)
+            extractBucket(job, id);
+        else{
+            relaxEdges(job, id, step == STEP_LIGHT);
+            waitBarrier(&job->barrier);
+            applyRequests(job, id, step == STEP_LIGHT);
+        }
+        waitBarrier(&job->barrier);
+    }
+    return 0;
+}
+
+static void freeOwners(DeltaJob *job){
+    if (job->owners == NULL)
+        return;
+    for (int i = 0; i < job->threads; ++i) {
+        Owner *owner = &job->owners[i];
+        if (owner->buckets != NULL){
+            for (int b = 0; b < job->bucketCount; ++b)
+                free(owner->buckets[b].items);
+        }
+        if (owner->outbox != NULL){
+            for (int o = 0; o < job->threads; ++o)
+                free(owner->outbox[o].items);
+        }
+        free(owner->buckets);
+        free(owner->outbox);
+        free(owner->frontier.items);
+        free(owner->next.items);
+        free(owner->settled.items);
+    }
+    free(job->owners);
+}
+
+/*
+ * Shortest distances from one vertex to all the others on several threads
+ * @param adjacency is the graph as neighbour lists
+ * @param startPoint of the search
+ * @param delta is the width of the buckets (0 or less: the average edge weight)
+ * @param threads is the number of threads used (less than 1: number of CPUs)
+ * @param dist is an array of adjacency->size, the shortest distances are placed here (DBL_MAX: unreachable)
+ * @return false if unable to allocate memory or to create a thread
+ *
+ * @date 2026.10.19.
+ */
+bool deltaStepping(const AdjacencyList *adjacency, int startPoint, double delta, int threads, double *dist){
+    int size = adjacency->size;
+    int edges = adjacency->offsets[size];
+    double maxWeight = 0;
+    double sumWeight = 0;
+    for (int e = 0; e < edges; ++e) {
+        sumWeight += adjacency->weights[e];
+        if (adjacency->weights[e] > maxWeight)
+            maxWeight = adjacency->weights[e];
+    }
+    if (delta <= 0)
+        delta = edges > 0 ? sumWeight / edges : 1;
+    if (threads < 1)
+        threads = SDL_GetCPUCount();
+
+    DeltaJob job;
+    job.adjacency = adjacency;
+    job.delta = delta;
+    job.threads = threads;
+    //Every tentative distance is less than a bucket plus the heaviest edge ahead of the current bucket
+    job.bucketCount = (int) (maxWeight / delta) + 2;
+    job.dist = dist;
+    job.mark = (int*) malloc(size * sizeof(int));
+    job.settledMark = (int*) malloc(size * sizeof(int));
+    job.owners = (Owner*) calloc(threads, sizeof(Owner));
+    SDL_AtomicSet(&job.barrier.count, threads);
+    job.barrier.mutex = SDL_CreateMutex();
+    job.barrier.cond = SDL_CreateCond();
+    SDL_AtomicSet(&job.barrier.waiting, 0);
+    SDL_AtomicSet(&job.barrier.generation, 0);
+    SDL_AtomicSet(&job.failed, 0);
+    Worker *workers = (Worker*) malloc(threads * sizeof(Worker));
+    SDL_Thread **handles = (SDL_Thread**) malloc(threads * sizeof(SDL_Thread*));
+
+    bool success = job.mark != NULL && job.settledMark != NULL && job.owners != NULL
+                   && job.barrier.mutex != NULL && job.barrier.cond != NULL && workers != NULL && handles != NULL;
+    for (int i = 0; i < threads && success; ++i) {
+        job.owners[i].buckets = (IntVector*) calloc(job.bucketCount, sizeof(IntVector));
+        job.owners[i].outbox = (RequestVector*) calloc(threads, sizeof(RequestVector));
+        if (job.owners[i].buckets == NULL || job.owners[i].outbox == NULL)
+            success = false;
+    }
+
+    if (success){
+        for (int i = 0; i < size; ++i) {
+            dist[i] = DBL_MAX;
+            job.mark[i] = -1;
+            job.settledMark[i] = -1;
+        }
+        dist[startPoint] = 0;
+        success = pushInt(&job.owners[startPoint % threads].buckets[0], startPoint);
+        //The first decision moves from this "previous heavy step" to bucket 0
+        job.step = STEP_HEAVY;
+        job.current = -1;
+        job.round = 0;
+    }
+
+    if (success){
+        //The calling thread is worker 0
+        int started = 0;
+        for (int i = 0; i < threads; ++i) {
+            workers[i].job = &job;
+            workers[i].id = i;
+        }
+        for (int i = 1; i < threads; ++i) {
+            handles[i] = SDL_CreateThread(deltaThread, "deltastep", &workers[i]);
+            if (handles[i] == NULL)
+                break;
+            started++;
+        }
+        if (started == threads - 1)
+            deltaThread(&workers[0]);
+        else{
+            //The started threads are waiting at the first barrier, they are released into STEP_DONE
+            success = false;
+            job.step = STEP_DONE;
+            SDL_AtomicSet(&job.barrier.count, started + 1);
+            waitBarrier(&job.barrier);
+        }
+        for (int i = 1; i <= started; ++i)
+            SDL_WaitThread(handles[i], NULL);
+        if (SDL_AtomicGet(&job.failed))
+            success = false;
+    }
+
+    freeOwners(&job);
+    free(job.mark);
+    free(job.settledMark);
+    if (job.barrier.mutex != NULL)
+        SDL_DestroyMutex(job.barrier.mutex);
+    if (job.barrier.cond != NULL)
+        SDL_DestroyCond(job.barrier.cond);
+    free(workers);
+    free(handles);
+    return success;
+}
@@ -0,0 +1,13 @@
+//
+// Created by Mark on 10/19/2026
+//
+
+#include <stdbool.h>
+#include "managegraph.h"
+
+#ifndef DELTASTEP_H
+#define DELTASTEP_H
+
+bool deltaStepping(const AdjacencyList *adjacency, int startPoint, double delta, int threads, double *dist);
+
+#endif //DELTASTEP_H
@@ -0,0 +1,169 @@
+//
+// Created by Mark on 10/19/2026
+//
+// Many-to-many distance tables: one shortest path tree per source, the sources are shared between threads
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+
+#include "distancematrix.h"
+#include "managegraph.h"
+#include "../debugmalloc.h"
+
+typedef struct{
+    const AdjacencyList *adjacency;
+    const int *sources, *targets;
+    int sourceCount, targetCount;
+    double *matrix;
+    SDL_atomic_t nextSource; //the threads take the sources one by one from here
+    SDL_atomic_t failed;
+}MatrixJob;
+
+/*
+ * One worker: builds the shortest path tree of the next free source, and copies the targets' row to the matrix
+ * @param data is the shared job
+ *
+ * @date 2026.10.19.
+ */
+static int matrixThread(void *data){
+    MatrixJob *job = (MatrixJob*) data;
+    double *dist = (double*) malloc(job->adjacency->size * sizeof(double));
+    if (dist == NULL){
+        SDL_AtomicSet(&job->failed, 1);
+        return 1;
+    }
+    int source;
+    while ((source = SDL_AtomicAdd(&job->nextSource, 1)) < job->sourceCount){
+        if (!shortestPathTree(job->adjacency, job->sources[source], dist, NULL)){
+            SDL_AtomicSet(&job->failed, 1);
+            break;
+        }
+        double *row = job->matrix + (size_t) source * job->targetCount;
+        for (int i = 0; i < job->targetCount; ++i)
+            row[i] = dist[job->targets[i]];
+    }
+    free(dist);
+    return 0;
+}
+
+/*
+ * Calculates the shortest distance between every source and every target
+ * @param adjacency is the graph as neighbour lists
+ * @param sources and sourceCount are the rows of the matrix
+ * @param targets and targetCount are the columns of the matrix
+ * @param threads is the number of threads used, at most the number of sources (less than 1: number of CPUs)
+ *
+ * @return the dense matrix in row order: matrix[s * targetCount + t] is the distance from sources[s] to targets[t]
+ * DBL_MAX signs that there is no connection.
+ * Not-normal return value:
+ *  - NULL: error with malloc, or the matrix does not fit in the memory
+ *
+ * @date 2026.10.19.
+ */
+double* distanceMatrix(const AdjacencyList *adjacency, const int *sources, int sourceCount,
+                       const int *targets, int targetCount, int threads){
+    if (sourceCount < 0 || targetCount < 0 || (targetCount > 0 && (size_t) sourceCount > SIZE_MAX / sizeof(double) / targetCount))
+        return NULL;
+    size_t cells = (size_t) sourceCount * targetCount;
+    double *matrix = (double*) malloc(cells * sizeof(double));
+    if (matrix == NULL && cells != 0)
+        return NULL;
+    if (threads < 1)
+        threads = SDL_GetCPUCount();
+    if (threads > sourceCount)
+        threads = sourceCount;
+
+    MatrixJob job = {.adjacency = adjacency, .sources = sources, .targets = targets,
+                     .sourceCount = sourceCount, .targetCount = targetCount, .matrix = matrix};
+    SDL_AtomicSet(&job.nextSource, 0);
+    SDL_AtomicSet(&job.failed, 0);
+
+    //The calling thread is a worker too, the sources are shared by the threads that could be started
+    SDL_Thread *workers[threads > 1 ? threads - 1 : 1];
+    int started = 0;
+    for (int i = 0; i < threads - 1; ++i) {
+        workers[started] = SDL_CreateThread(matrixThread, "matrix", &job);
+        if (workers[started] != NULL)
+            started++;
+    }
+    matrixThread(&job);
+    for (int i = 0; i < started; ++i)
+        SDL_WaitThread(workers[i], NULL);
+
+    if (SDL_AtomicGet(&job.failed)){
+        free(matrix);
+        return NULL;
+    }
+    return matrix;
+}
+
+/*
+ * Writes the matrix to a binary file:
+ * "RPDM", the number of rows and columns as 32 bit integers, then the distances as doubles in row order
+ * (the byte order is the machine's own)
+ * @param filename is the path of the file
+ * @param matrix is the result of distanceMatrix
+ * @param rows and columns are the size of the matrix
+ * @return whether the writing is successful or not
+ *
+ * @date 2026.10.19.
+ */
+bool writeDistanceMatrix(const char *filename, const double *matrix, int rows, int columns){
+    FILE *fp;
+    fp = fopen(filename, "wb");
+
+    //Error handling
+    if (fp == NULL){
+        printf("Error with opening file: %s", filename);
+        return false;
+    }
+    int32_t size[2] = {rows, columns};
+    size_t cells = (size_t) rows * columns;
+    bool success = fwrite("RPDM", 1, 4, fp) == 4
+                   && fwrite(size, sizeof(int32_t), 2, fp) == 2
+                   && fwrite(matrix, sizeof(double), cells, fp) == cells;
+    if (fclose(fp) != 0)
+        success = false;
+    return success;
+}
+
+/*
+ * Reads a matrix written by writeDistanceMatrix
+ * @param filename is the path of the file
+ * @param rows and columns get the size of the matrix
+ * @return the distances in row order, NULL if the file cannot be read, it is not a matrix or unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+double* readDistanceMatrix(const char *filename, int *rows, int *columns){
+    FILE *fp;
+    fp = fopen(filename, "rb");
+
+    //Error handling
+    if (fp == NULL){
+        printf("Error with opening file: %s", filename);
+        return NULL;
+    }
+    char magic[4];
+    int32_t size[2];
+    double *matrix = NULL;
+    if (fread(magic, 1, 4, fp) == 4 && memcmp(magic, "RPDM", 4) == 0 && fread(size, sizeof(int32_t), 2, fp) == 2
+        && size[0] >= 0 && size[1] >= 0){
+        size_t cells = (size_t) size[0] * size[1];
+        matrix = (double*) malloc(cells * sizeof(double));
+        if (matrix != NULL && fread(matrix, sizeof(double), cells, fp) != cells){
+            free(matrix);
+            matrix = NULL;
+        }
+    }
+    fclose(fp);
+    if (matrix != NULL){
+        *rows = size[0];
+        *columns = size[1];
+    }
+    return matrix;
+}
@@ -0,0 +1,16 @@
+//
+// Created by Mark on 10/19/2026
+//
+
+#include <stdbool.h>
+#include "managegraph.h"
+
+#ifndef DISTANCEMATRIX_H
+#define DISTANCEMATRIX_H
+
+double* distanceMatrix(const AdjacencyList *adjacency, const int *sources, int sourceCount,
+                       const int *targets, int targetCount, int threads);
+bool writeDistanceMatrix(const char *filename, const double *matrix, int rows, int columns);
+double* readDistanceMatrix(const char *filename, int *rows, int *columns);
+
+#endif //DISTANCEMATRIX_H
@@ -6,7 +6,6 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include <stdlib.h>
-#include <float.h>
 #include <SDL2/SDL.h>
 #include <SDL2_gfxPrimitives.h>
 #include <SDL2/SDL_ttf.h>
@@ -16,11 +15,6 @@
 #include "managegraph.h"
 #include "../debugmalloc.h"
 
-//RGB color code
-typedef struct{
-    int red, green, blue;
-}RGB;
-
 //initialize SDL
 void sdl_init(char const *name, int width, int heigth, SDL_Window **pwindow, SDL_Renderer **prenderer) {
     if (SDL_Init(SDL_INIT_EVERYTHING) < 0) {
@@ -44,6 +38,38 @@ void sdl_init(char const *name, int width, int heigth, SDL_Window **pwindow, SDL
     *prenderer = renderer;
 }
 
+/*
+ * Set up SDL without a window: the UI is drawn to a surface in memory (replaying a recorded session)
+ * @param width and heigth are the size of the surface
+ * @param psurface gets the surface, it is freed with SDL_FreeSurface
+ * @param prenderer gets the renderer drawing to the surface
+ *
+ * @date 2026.10.19.
+ */
+void sdl_init_offscreen(int width, int heigth, SDL_Surface **psurface, SDL_Renderer **prenderer) {
+    //No display is needed, the dummy video driver works on servers too
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+    if (SDL_Init(SDL_INIT_VIDEO) < 0) {
+        SDL_Log("Error with starting SDL: %s", SDL_GetError());
+        exit(1);
+    }
+    SDL_Surface *surface = SDL_CreateRGBSurfaceWithFormat(0, width, heigth, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (surface == NULL) {
+        SDL_Log("Error with creating surface: %s", SDL_GetError());
+        exit(1);
+    }
+    SDL_Renderer *renderer = SDL_CreateSoftwareRenderer(surface);
+    if (renderer == NULL) {
+        SDL_Log("Error with creating renderer: %s", SDL_GetError());
+        exit(1);
+    }
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 0);
+    SDL_RenderClear(renderer);
+
+    *psurface = surface;
+    *prenderer = renderer;
+}
+
 /*
  *Write to the SDL window
  *@param renderer is the SDL renderer
@@ -99,21 +125,23 @@ static void drawMap(SDL_Renderer *renderer, int windowY, const Border border){
  *@param renderer SDL renderer
  *@param windowY is the height of the window
  *@param position the position structure with size and location list in it
- *@param graph the graph structure with the 2D array with the connections and the graph's size
+ *@param adjacency the graph as neighbour lists, every road is in the lists of both of its ends
  *
  *@date 2019.11.09.
 */
-static void drawGraph(SDL_Renderer *renderer, int windowY, const Position position, const Graph graph){
+static void drawGraph(SDL_Renderer *renderer, int windowY, const Position position, const AdjacencyList *adjacency){
     double x1, x2, y1, y2;
-    for (int i=0; i<graph.size; ++i){
-        for (int j=0; j<graph.size; ++j){
-            if (graph.values[i][j] != DBL_MAX){
-                x1 = position.values[i].x;
-                y1 = windowY - (position.values[i].y);
-                x2 = position.values[j].x;
-                y2 = windowY - (position.values[j].y);
-                lineRGBA(renderer, (int) x1, (int) y1, (int) x2, (int) y2, 0, 0, 0, 255);
-            }
+    for (int i=0; i<adjacency->size; ++i){
+        for (int e=adjacency->offsets[i]; e<adjacency->offsets[i+1]; ++e){
+            int j = adjacency->targets[e];
+            //The road is drawn once, from its smaller end
+            if (j < i)
+                continue;
+            x1 = position.values[i].x;
+            y1 = windowY - (position.values[i].y);
+            x2 = position.values[j].x;
+            y2 = windowY - (position.values[j].y);
+            lineRGBA(renderer, (int) x1, (int) y1, (int) x2, (int) y2, 0, 0, 0, 255);
         }
     }
 }
@@ -136,7 +164,7 @@ static void drawPoints(SDL_Renderer *renderer, int windowY, const Position posit
 }
 
 /*
- *Draws the two buttons on the left of the UI
+ *Draws the buttons on the left of the UI, the alternatives and the reachable button are at the bottom
  *@param renderer SDL renderer
  *
  *@date 2019.11.09.
@@ -145,17 +173,52 @@ static bool drawButtons(SDL_Renderer *renderer){
     Sint16 ButtonX[] = {1200, 1450, 1450, 1200};
     Sint16 newButtonY[] = {100, 100, 150, 150};
     Sint16 planButtonY[] = {170, 170, 220, 220};
+    Sint16 alternativesButtonY[] = {510, 510, 560, 560};
+    Sint16 reachableButtonY[] = {580, 580, 630, 630};
 
     if(!printTextToSDL(renderer, "Tervezés", 1270, 175, 32)) //Planning
         return false;
     if(!printTextToSDL(renderer, "Új útvonal", 1260, 105, 32)) //New route
         return false;
+    if(!printTextToSDL(renderer, "Alternatívák", 1245, 518, 28)) //Alternatives
+        return false;
+    if(!printTextToSDL(renderer, "Elérhető 50 km", 1225, 588, 28)) //Reachable within 50 km
+        return false;
 
     filledPolygonRGBA(renderer, ButtonX, newButtonY, 4, 0, 0, 0, 30);
     filledPolygonRGBA(renderer, ButtonX, planButtonY, 4, 0, 0, 0, 30);
+    filledPolygonRGBA(renderer, ButtonX, alternativesButtonY, 4, 0, 0, 0, 30);
+    filledPolygonRGBA(renderer, ButtonX, reachableButtonY, 4, 0, 0, 0, 30);
 
     aapolygonRGBA(renderer, ButtonX, newButtonY, 4, 0, 0, 0, 255);
     aapolygonRGBA(renderer, ButtonX, planButtonY, 4, 0, 0, 0, 255);
+    aapolygonRGBA(renderer, ButtonX, alternativesButtonY, 4, 0, 0, 0, 255);
+    aapolygonRGBA(renderer, ButtonX, reachableButtonY, 4, 0, 0, 0, 255);
+    return true;
+}
+
+/*
+ *Draws the search box above the buttons with the typed text and the best match under it
+ *@param renderer SDL renderer
+ *@param text is the typed text
+ *@param hint is the line under the box, NULL: how to use the box
+ *
+ *@date 2026.10.19.
+*/
+bool drawSearchBox(SDL_Renderer *renderer, const char *text, const char *hint){
+    Sint16 boxX[] = {1200, 1450, 1450, 1200};
+    Sint16 boxY[] = {30, 30, 70, 70};
+
+    //Painting over the previous state with the background, then the white field
+    boxRGBA(renderer, 1195, 25, 1499, 97, 225, 225, 225, 255);
+    boxRGBA(renderer, 1200, 30, 1450, 70, 255, 255, 255, 255);
+    aapolygonRGBA(renderer, boxX, boxY, 4, 0, 0, 0, 255);
+    if (hint == NULL)
+        hint = "Hely keresése, Enter: kiválasztás"; //Search for a place, Enter: choose
+    if (text[0] != '\0' && !printTextToSDL(renderer, (char*) text, 1205, 35, 24))
+        return false;
+    if (!printTextToSDL(renderer, (char*) hint, 1200, 74, 16))
+        return false;
     return true;
 }
 
@@ -164,19 +227,21 @@ static bool drawButtons(SDL_Renderer *renderer){
  * @param renderer SDL renderer
  * @param windowY is the window's height
  * @param position vertex array
- * @param graph
+ * @param adjacency the graph as neighbour lists
  * @param border border points
  *
  * @date 2019.11.11.
 */
-bool drawUI(SDL_Renderer *renderer, int windowX, int windowY, const Position position, const Graph graph, const Border border){
+bool drawUI(SDL_Renderer *renderer, int windowX, int windowY, const Position position, const AdjacencyList *adjacency, const Border border){
     boxRGBA(renderer, 0, 0, windowX, windowY, 255, 255, 255, 255);
     boxRGBA(renderer, 0, 0, windowX, windowY, 0, 0, 0, 30);
     drawMap(renderer, windowY, border);
-    drawGraph(renderer, windowY, position, graph);
+    drawGraph(renderer, windowY, position, adjacency);
     drawPoints(renderer, windowY, position);
     if(drawButtons(renderer) == false)
         return false;
+    if(drawSearchBox(renderer, "", NULL) == false)
+        return false;
 
     SDL_RenderPresent(renderer);
     return true;
@@ -189,15 +254,16 @@ bool drawUI(SDL_Renderer *renderer, int windowX, int windowY, const Position pos
  *@param windowY is height of the window
  *@param position is vertex array
  *@param first and second are the points
+ *@param color is the color of the line, red for the optimal route, others for the alternatives
  *
  *@date 2019.11.09.
 */
-void connectTwoPoints(SDL_Renderer *renderer, int windowY, const Position position, int first, int second){
+void connectTwoPoints(SDL_Renderer *renderer, int windowY, const Position position, int first, int second, RGB color){
     double x1 = position.values[first].x;
     double y1 = windowY - position.values[first].y;
     double x2 = position.values[second].x;
     double y2 = windowY - position.values[second].y;
-    thickLineRGBA(renderer, x1, y1, x2, y2, 3, 255, 0, 0, 255);
+    thickLineRGBA(renderer, x1, y1, x2, y2, 3, color.red, color.green, color.blue, 255);
     SDL_RenderPresent(renderer);
 }
 
@@ -301,3 +367,39 @@ bool displayRoute(SDL_Renderer *renderer, int num, Location place, double distan
 
     return true;
 }
+
+/* Displays how many legs of the route are planned so far, the previous state is painted over
+ * @param renderer SDL renderer
+ * @param done is the number of planned legs
+ * @param all is the number of legs of the route
+ *
+ * @date 2026.10.19.
+*/
+bool displayProgress(SDL_Renderer *renderer, int done, int all){
+    const int startx = 1200;
+    const int starty = 225;
+    const int size = 18;
+    //Same color as the background drawn by drawUI
+    boxRGBA(renderer, startx, starty, startx+250, starty+size+4, 225, 225, 225, 255);
+    char progressText[40];
+    sprintf(progressText, "Tervezés: %d / %d", done, all); //Planning
+    if(printTextToSDL(renderer, progressText, startx, starty, size) == false)
+        return false;
+
+    return true;
+}
+
+/*
+ *Draws the region of the reachable places, for example the result of reachableRegion
+ *@param renderer SDL renderer
+ *@param region is the polygon in window coordinates
+ *
+ *@date 2026.10.19.
+*/
+void drawReachableRegion(SDL_Renderer *renderer, const Border region){
+    if (region.size >= 3){
+        filledPolygonRGBA(renderer, region.x, region.y, region.size, 0, 0, 255, 40);
+        aapolygonRGBA(renderer, region.x, region.y, region.size, 0, 0, 255, 255);
+    }
+    SDL_RenderPresent(renderer);
+}
@@ -10,12 +10,21 @@
 #ifndef DRAWUI
 #define DRAWUI
 
+//RGB color code
+typedef struct{
+    int red, green, blue;
+}RGB;
+
 void sdl_init(char const *name, int width, int heigth, SDL_Window **pwindow, SDL_Renderer **prenderer);
-bool drawUI(SDL_Renderer *renderer, int windowX, int windowY, const Position position, const Graph graph, const Border border);
-void connectTwoPoints(SDL_Renderer *renderer, int windowY, const Position position, int first, int second);
+void sdl_init_offscreen(int width, int heigth, SDL_Surface **psurface, SDL_Renderer **prenderer);
+bool drawUI(SDL_Renderer *renderer, int windowX, int windowY, const Position position, const AdjacencyList *adjacency, const Border border);
+void connectTwoPoints(SDL_Renderer *renderer, int windowY, const Position position, int first, int second, RGB color);
 int* vertexesChosen(SDL_Renderer *renderer, int windowY, const Position position, int vertex, int *chosenpoints, int *size);
 bool displayFirstRoute(SDL_Renderer *renderer, Location place);
 bool displayRoute(SDL_Renderer *renderer, int num, Location place, double distance, char *text);
+bool displayProgress(SDL_Renderer *renderer, int done, int all);
+void drawReachableRegion(SDL_Renderer *renderer, const Border region);
+bool drawSearchBox(SDL_Renderer *renderer, const char *text, const char *hint);
 
 
 #endif // DRAWUI
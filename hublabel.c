@@ -0,0 +1,467 @@
+//
+// Created by Mark on 10/19/2026
+//
+// Hub labeling: distance queries as the merge of two sorted labels, built with pruned Dijkstra searches
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <SDL2/SDL.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "hublabel.h"
+#include "managegraph.h"
+#include "minheap.h"
+#include "../debugmalloc.h"
+
+/*
+ * The label of every vertex contains hubs with the exact distance to them, so that for every pair of vertexes
+ * a hub on their shortest path is in both labels. The distance is then the minimum of d(from,h) + d(h,to)
+ * over the common hubs h.
+ *
+ * Preprocessing (pruned landmark labeling): the vertexes are taken in order of decreasing degree, and a
+ * Dijkstra search is run from each of them. When a reached vertex's distance is already answered by the
+ * labels built so far, the search does not continue from there. Otherwise the root is added to its label.
+ * The roots come in increasing rank, therefore the labels are sorted without any extra work.
+ *
+ * The distances are stored and summed in fixed-point (LABEL_SCALE units in a km), so a query gives exactly
+ * the length of the shortest route summed edge by edge in the same units.
+ */
+
+typedef struct{
+    int degree, vertex;
+}RankItem;
+
+typedef struct{
+    int size, capacity;
+    uint32_t *hubs;
+    uint32_t *dists;
+}LabelVector;
+
+//The file starts with this header, then come the offsets, the hubs and the distances, each aligned to 8 bytes
+typedef struct{
+    char magic[4];
+    uint32_t version;
+    uint32_t size;
+    uint32_t entries;
+}HubLabelHeader;
+
+static int compareRank(const void *a, const void *b){
+    const RankItem *first = (const RankItem*) a;
+    const RankItem *second = (const RankItem*) b;
+    if (first->degree != second->degree)
+        return second->degree - first->degree;
+    return first->vertex - second->vertex;
+}
+
+static bool appendLabel(LabelVector *label, uint32_t hub, uint32_t dist){
+    if (label->size == label->capacity){
+        int capacity = label->capacity == 0 ? 4 : 2 * label->capacity;
+        uint32_t *hubs = (uint32_t*) realloc(label->hubs, capacity * sizeof(uint32_t));
+        if (hubs == NULL)
+            return false;
+        label->hubs = hubs;
+        uint32_t *dists = (uint32_t*) realloc(label->dists, capacity * sizeof(uint32_t));
+        if (dists == NULL)
+            return false;
+        label->dists = dists;
+        label->capacity = capacity;
+    }
+    label->hubs[label->size] = hub;
+    label->dists[label->size] = dist;
+    label->size++;
+    return true;
+}
+
+static size_t align8(size_t size){
+    return (size + 7) & ~(size_t) 7;
+}
+
+/*
+ * Sets the array pointers of the labels to their place in a block with the file's layout
+ * @param labels gets the pointers
+ * @param block is the beginning of the header
+ *
+ * @date 2026.10.19.
+ */
+static void pointIntoBlock(HubLabels *labels, char *block){
+    const HubLabelHeader *header = (const HubLabelHeader*) block;
+    size_t offsetsAt = align8(sizeof(HubLabelHeader));
+    size_t hubsAt = offsetsAt + align8(((size_t) header->size + 1) * sizeof(uint32_t));
+    size_t distsAt = hubsAt + align8(header->entries * sizeof(uint32_t));
+    labels->size = (int) header->size;
+    labels->offsets = (uint32_t*) (block + offsetsAt);
+    labels->hubs = (uint32_t*) (block + hubsAt);
+    labels->dists = (uint32_t*) (block + distsAt);
+}
+
+/*
+ * @return the size of the file with the given number of vertexes and label entries
+ *
+ * @date 2026.10.19.
+ */
+static size_t blockSize(uint32_t size, uint32_t entries){
+    return align8(sizeof(HubLabelHeader)) + align8(((size_t) size + 1) * sizeof(uint32_t))
+           + align8(entries * sizeof(uint32_t)) + entries * sizeof(uint32_t);
+}
+
+/*
+ * Builds the hub labels of the graph
+ * @param adjacency is the graph as neighbour lists, the weights are rounded to 10 m
+ * @param labels is where the labels are placed, free it with freeHubLabels
+ * @return false if unable to allocate memory or a distance does not fit in 32 bits
+ *
+ * @date 2026.10.19.
+ */
+bool buildHubLabels(const AdjacencyList *adjacency, HubLabels *labels){
+    int size = adjacency->size;
+    RankItem *order = (RankItem*) malloc(size * sizeof(RankItem));
+    LabelVector *vectors = (LabelVector*) calloc(size, sizeof(LabelVector));
+    uint32_t *dist = (uint32_t*) malloc(size * sizeof(uint32_t));
+    uint32_t *rootLabel = (uint32_t*) malloc(size * sizeof(uint32_t)); //the root's label indexed by the hub
+    int *visited = (int*) malloc(size * sizeof(int));
+    MinHeap heap = {0, 0, NULL};
+    bool success = order != NULL && vectors != NULL && dist != NULL && rootLabel != NULL && visited != NULL
+                   && initHeap(&heap, size);
+
+    if (success){
+        for (int i = 0; i < size; ++i) {
+            order[i].degree = adjacency->offsets[i+1] - adjacency->offsets[i];
+            order[i].vertex = i;
+            dist[i] = UINT32_MAX;
+            rootLabel[i] = UINT32_MAX;
+        }
+        qsort(order, size, sizeof(RankItem), compareRank);
+    }
+
+    for (int rank = 0; rank < size && success; ++rank) {
+        int root = order[rank].vertex;
+        LabelVector *own = &vectors[root];
+        for (int i = 0; i < own->size; ++i)
+            rootLabel[own->hubs[i]] = own->dists[i];
+
+        int visitedCount = 0;
+        dist[root] = 0;
+        visited[visitedCount++] = root;
+        heap.size = 0;
+        pushHeap(&heap, 0, root);
+        while (heap.size > 0 && success){
+            HeapItem item = popHeap(&heap);
+            uint32_t current = dist[item.vertex];
+            if ((uint32_t) item.key > current)
+                continue;
+            //Pruning: the labels built so far already know this distance
+            LabelVector *label = &vectors[item.vertex];
+            uint64_t known = UINT64_MAX;
+            for (int i = 0; i < label->size; ++i) {
+                if (rootLabel[label->hubs[i]] != UINT32_MAX
+                    && (uint64_t) rootLabel[label->hubs[i]] + label->dists[i] < known)
+                    known = (uint64_t) rootLabel[label->hubs[i]] + label->dists[i];
+            }
+            if (known <= current)
+                continue;
+            if (!appendLabel(label, (uint32_t) rank, current)){
+                success = false;
+                break;
+            }
+            for (int e = adjacency->offsets[item.vertex]; e < adjacency->offsets[item.vertex + 1]; ++e) {
+                int next = adjacency->targets[e];
+                uint64_t weight = current + (uint64_t) llround(adjacency->weights[e] * LABEL_SCALE);
+                if (weight >= UINT32_MAX){
+                    //The distance does not fit in the file
+                    success = false;
+                    break;
+                }
+                if (weight < dist[next]){
+                    if (dist[next] == UINT32_MAX)
+                        visited[visitedCount++] = next;
+                    dist[next] = (uint32_t) weight;
+                    if (!pushHeap(&heap, (double) weight, next))
+                        success = false;
+                }
+            }
+        }
+        //Only the touched entries are reset, so the small searches of the later roots stay cheap
+        for (int i = 0; i < visitedCount; ++i)
+            dist[visited[i]] = UINT32_MAX;
+        for (int i = 0; i < own->size; ++i)
+            rootLabel[own->hubs[i]] = UINT32_MAX;
+    }
+
+    //Copying the labels into one block with the layout of the file
+    uint32_t entries = 0;
+    if (success){
+        for (int i = 0; i < size; ++i)
+            entries += vectors[i].size;
+        labels->fileSize = blockSize(size, entries);
+        labels->file = calloc(1, labels->fileSize);
+        labels->mapped = false;
+        success = labels->file != NULL;
+    }
+    if (success){
+        HubLabelHeader *header = (HubLabelHeader*) labels->file;
+        memcpy(header->magic, "RPHL", 4);
+        header->version = 2;
+        header->size = size;
+        header->entries = entries;
+        pointIntoBlock(labels, (char*) labels->file);
+        uint32_t at = 0;
+        for (int i = 0; i < size; ++i) {
+            labels->offsets[i] = at;
+            memcpy(labels->hubs + at, vectors[i].hubs, vectors[i].size * sizeof(uint32_t));
+            memcpy(labels->dists + at, vectors[i].dists, vectors[i].size * sizeof(uint32_t));
+            at += vectors[i].size;
+        }
+        labels->offsets[size] = at;
+    }
+
+    if (vectors != NULL){
+        for (int i = 0; i < size; ++i) {
+            free(vectors[i].hubs);
+            free(vectors[i].dists);
+        }
+    }
+    free(vectors);
+    free(order);
+    free(dist);
+    free(rootLabel);
+    free(visited);
+    freeHeap(&heap);
+    return success;
+}
+
+/*
+ * Shortest distance between two vertexes from their labels
+ * @param labels are the hub labels
+ * @param from and to are the two vertexes
+ * @return the distance in km (a whole number of LABEL_SCALE units), DBL_MAX if there is no connection
+ *
+ * @date 2026.10.19.
+ */
+double hubLabelDistance(const HubLabels *labels, int from, int to){
+    const uint32_t *a = labels->hubs + labels->offsets[from];
+    const uint32_t *b = labels->hubs + labels->offsets[to];
+    const uint32_t *da = labels->dists + labels->offsets[from];
+    const uint32_t *db = labels->dists + labels->offsets[to];
+    int na = labels->offsets[from + 1] - labels->offsets[from];
+    int nb = labels->offsets[to + 1] - labels->offsets[to];
+    uint64_t best = UINT64_MAX;
+    int i = 0, j = 0;
+#ifdef __SSE2__
+    /*
+     * Comparing four hubs with four hubs at once: the block of b is compared with the block of a in all four
+     * rotations. The block with the smaller last hub cannot have more common hubs, so that one is stepped.
+     */
+    while (i + 4 <= na && j + 4 <= nb){
+        __m128i va = _mm_loadu_si128((const __m128i*) (a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*) (b + j));
+        __m128i eq = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi32(va, vb),
+                             _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+                _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+                             _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)))));
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(eq));
+        for (int k = 0; mask != 0; ++k, mask >>= 1) {
+            if (mask & 1){
+                for (int l = j; l < j + 4; ++l) {
+                    if (b[l] == a[i+k] && (uint64_t) da[i+k] + db[l] < best)
+                        best = (uint64_t) da[i+k] + db[l];
+                }
+            }
+        }
+        uint32_t lastA = a[i+3];
+        uint32_t lastB = b[j+3];
+        if (lastA <= lastB)
+            i += 4;
+        if (lastB <= lastA)
+            j += 4;
+    }
+#endif
+    while (i < na && j < nb){
+        if (a[i] < b[j])
+            i++;
+        else if (a[i] > b[j])
+            j++;
+        else{
+            if ((uint64_t) da[i] + db[j] < best)
+                best = (uint64_t) da[i] + db[j];
+            i++;
+            j++;
+        }
+    }
+    return best == UINT64_MAX ? DBL_MAX : (double) best / LABEL_SCALE;
+}
+
+/*
+ * Writes the labels to a binary file which can be mapped into memory as it is
+ * (the byte order is the machine's own)
+ * @param filename is the path of the file
+ * @param labels are the hub labels
+ * @return whether the writing is successful or not
+ *
+ * @date 2026.10.19.
+ */
+bool writeHubLabels(const char *filename, const HubLabels *labels){
+    FILE *fp;
+    fp = fopen(filename, "wb");
+
+    //Error handling
+    if (fp == NULL){
+        printf("Error with opening file: %s", filename);
+        return false;
+    }
+    bool success = fwrite(labels->file, 1, labels->fileSize, fp) == labels->fileSize;
+    if (fclose(fp) != 0)
+        success = false;
+    return success;
+}
+
+/*
+ * Checks the arrays of a loaded file: the labels have to be in order, inside the file, and the hubs have to be vertexes
+ * @param labels are the labels pointing into the file
+ * @param entries is the number of hubs in the header
+ * @return whether the labels can be used
+ *
+ * @date 2026.10.19.
+ */
+static bool validLabels(const HubLabels *labels, uint32_t entries){
+    if (labels->offsets[0] != 0 || labels->offsets[labels->size] != entries)
+        return false;
+    for (int i = 0; i < labels->size; ++i) {
+        if (labels->offsets[i] > labels->offsets[i + 1])
+            return false;
+    }
+    for (uint32_t i = 0; i < entries; ++i) {
+        if (labels->hubs[i] >= (uint32_t) labels->size)
+            return false;
+    }
+    return true;
+}
+
+/*
+ * Loads the labels written by writeHubLabels. The file is mapped into memory, on Windows it is read.
+ * @param filename is the path of the file
+ * @param labels is where the labels are placed, free it with freeHubLabels
+ * @return false if the file cannot be opened, it is damaged or unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+bool loadHubLabels(const char *filename, HubLabels *labels){
+    size_t fileSize;
+    void *file;
+#ifndef _WIN32
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0){
+        printf("Error with opening file: %s", filename);
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t) info.st_size < sizeof(HubLabelHeader)){
+        close(fd);
+        return false;
+    }
+    fileSize = (size_t) info.st_size;
+    file = mmap(NULL, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (file == MAP_FAILED)
+        return false;
+#else
+    FILE *fp;
+    fp = fopen(filename, "rb");
+    if (fp == NULL){
+        printf("Error with opening file: %s", filename);
+        return false;
+    }
+    fseek(fp, 0, SEEK_END);
+    fileSize = (size_t) ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    file = malloc(fileSize);
+    if (file == NULL || fread(file, 1, fileSize, fp) != fileSize || fileSize < sizeof(HubLabelHeader)){
+        free(file);
+        fclose(fp);
+        return false;
+    }
+    fclose(fp);
+#endif
+    labels->file = file;
+    labels->fileSize = fileSize;
+#ifndef _WIN32
+    labels->mapped = true;
+#else
+    labels->mapped = false;
+#endif
+    const HubLabelHeader *header = (const HubLabelHeader*) file;
+    if (memcmp(header->magic, "RPHL", 4) != 0 || header->version != 2
+        || blockSize(header->size, header->entries) != fileSize){
+        printf("Damaged hub label file: %s\n", filename);
+        freeHubLabels(labels);
+        return false;
+    }
+    //The arrays are checked too, hubLabelDistance trusts the offsets
+    pointIntoBlock(labels, (char*) file);
+    if (header->size > INT_MAX || !validLabels(labels, header->entries)){
+        printf("Damaged hub label file: %s\n", filename);
+        freeHubLabels(labels);
+        return false;
+    }
+    return true;
+}
+
+void freeHubLabels(HubLabels *labels){
+#ifndef _WIN32
+    if (labels->mapped)
+        munmap(labels->file, labels->fileSize);
+    else
+        free(labels->file);
+#else
+    free(labels->file);
+#endif
+    labels->file = NULL;
+    labels->offsets = NULL;
+    labels->hubs = NULL;
+    labels->dists = NULL;
+}
+
+/*
+ * Builds the labels of the graph and writes them to a file, the label sizes and the time of the
+ * preprocessing are printed
+ * @param filename is the path of the file
+ * @param adjacency is the graph as neighbour lists
+ * @return whether the building and the writing is successful or not
+ *
+ * @date 2026.10.19.
+ */
+bool buildHubLabelFile(const char *filename, const AdjacencyList *adjacency){
+    HubLabels labels;
+    Uint64 start = SDL_GetPerformanceCounter();
+    bool success = buildHubLabels(adjacency, &labels);
+    double time = (double) (SDL_GetPerformanceCounter() - start) * 1000.0 / (double) SDL_GetPerformanceFrequency();
+    if (!success)
+        return false;
+
+    int maxLabel = 0;
+    for (int i = 0; i < labels.size; ++i) {
+        if ((int) (labels.offsets[i+1] - labels.offsets[i]) > maxLabel)
+            maxLabel = labels.offsets[i+1] - labels.offsets[i];
+    }
+    printf("Hub labels of %d vertexes built in %.2f ms\n", labels.size, time);
+    printf("Label entries: %u, average label: %.2f, largest label: %d, file: %zu bytes\n",
+           labels.offsets[labels.size], labels.size ? (double) labels.offsets[labels.size] / labels.size : 0.0,
+           maxLabel, labels.fileSize);
+    success = writeHubLabels(filename, &labels);
+    freeHubLabels(&labels);
+    return success;
+}
@@ -0,0 +1,37 @@
+//
+// Created by Mark on 10/19/2026
+//
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "managegraph.h"
+
+#ifndef HUBLABEL_H
+#define HUBLABEL_H
+
+#define LABEL_SCALE 100  //fixed-point units of the label distances in a km (10 m)
+
+/*
+ * The label of vertex v: hubs[offsets[v]] ... hubs[offsets[v+1]-1] in increasing order with the distances
+ * from v in dists (in LABEL_SCALE units). The hubs are ranks, not vertex ids: the rank of a vertex is its place in the order
+ * of the preprocessing.
+ */
+typedef struct{
+    int size;
+    uint32_t *offsets;
+    uint32_t *hubs;
+    uint32_t *dists;
+    void *file;         //the block with the layout of the file, the arrays point into it
+    size_t fileSize;
+    bool mapped;        //whether the block is a mapped file or allocated memory
+}HubLabels;
+
+bool buildHubLabels(const AdjacencyList *adjacency, HubLabels *labels);
+double hubLabelDistance(const HubLabels *labels, int from, int to);
+bool writeHubLabels(const char *filename, const HubLabels *labels);
+bool loadHubLabels(const char *filename, HubLabels *labels);
+void freeHubLabels(HubLabels *labels);
+bool buildHubLabelFile(const char *filename, const AdjacencyList *adjacency);
+
+#endif //HUBLABEL_H
@@ -0,0 +1,666 @@
+//
+// Created by Mark on 10/19/2026
+//
+// Reading large szak.txt, csp.txt and hatar.txt style files with several threads
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include <SDL2/SDL.h>
+
+#include "ingest.h"
+#include "managefile.h"
+#include "managegraph.h"
+#include "../debugmalloc.h"
+
+/*
+ * The file is read in blocks. Every block is cut at line boundaries into one chunk per thread,
+ * the threads parse their chunk into their own record array, then the arrays are appended
+ * to the result in the order of the chunks, so the records keep the order of the lines.
+ * The unfinished last line of a block is moved to the beginning of the next one.
+ */
+
+#define BLOCK_SIZE (16 << 20)
+
+typedef bool (*LineParser)(const char *line, const char *end, void *record, const void *context);
+
+typedef struct{
+    char *values;
+    size_t count, capacity;
+    size_t recordSize;
+}RecordArray;
+
+typedef struct{
+    const char *begin, *end;
+    LineParser parse;
+    const void *context;
+    RecordArray records;
+    long long lines;
+    long long malformed;
+    long long reported[REPORTED_LINES]; //line numbers in the chunk from 0
+    bool failed;                        //unable to allocate memory
+}Chunk;
+
+/*
+ * Makes room for more records, the capacity is doubled
+ * @return false if unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+static bool reserveRecords(RecordArray *array, size_t count){
+    if (array->count + count <= array->capacity)
+        return true;
+    size_t capacity = array->capacity == 0 ? 1024 : array->capacity;
+    while (capacity < array->count + count)
+        capacity *= 2;
+    char *values = (char*) realloc(array->values, capacity * array->recordSize);
+    if (values == NULL)
+        return false;
+    array->values = values;
+    array->capacity = capacity;
+    return true;
+}
+
+static bool isSpace(char c){
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+static const char* skipSpaces(const char *p, const char *end){
+    while (p < end && isSpace(*p))
+        p++;
+    return p;
+}
+
+/*
+ * Parses a whole number which is followed by a space or the end of the line
+ * @param p is the current position in the line
+ * @param end is the end of the line
+ * @param value gets the number
+ * @return the position after the number, NULL if there is no valid number
+ *
+ * @date 2026.10.19.
+ */
+static const char* parseInteger(const char *p, const char *end, int *value){
+    p = skipSpaces(p, end);
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')){
+        negative = *p == '-';
+        p++;
+    }
+    if (p == end || *p < '0' || *p > '9')
+        return NULL;
+    long long result = 0;
+    while (p < end && *p >= '0' && *p <= '9'){
+        result = result * 10 + (*p - '0');
+        if (result > INT_MAX)
+            return NULL;
+        p++;
+    }
+    if (p < end && !isSpace(*p))
+        return NULL;
+    *value = (int) (negative ? -result : result);
+    return p;
+}
+
+/*
+ * Parses a decimal number which is followed by a space or the end of the line.
+ * The digits are collected into an integer and divided by a power of ten, both are exact,
+ * so the result is the correctly rounded value, the same as the one of strtod.
+ * Numbers with exponent or with too many digits are given to strtod (the C locale is never changed).
+ * @param p is the current position in the line
+ * @param end is the end of the line
+ * @param value gets the number
+ * @return the position after the number, NULL if there is no valid number
+ *
+ * @date 2026.10.19.
+ */
+static const char* parseNumber(const char *p, const char *end, double *value){
+    static const double powersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                         1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    p = skipSpaces(p, end);
+    const char *start = p;
+    bool negative = false;
+    if (p < end && (*p == '-' || *p == '+')){
+        negative = *p == '-';
+        p++;
+    }
+    uint64_t mantissa = 0;
+    int digits = 0, fraction = 0;
+    while (p < end && *p >= '0' && *p <= '9'){
+        if (digits < 19)
+            mantissa = mantissa * 10 + (uint64_t) (*p - '0');
+        digits++;
+        p++;
+    }
+    if (p < end && *p == '.'){
+        p++;
+        while (p < end && *p >= '0' && *p <= '9'){
+            if (digits < 19){
+                mantissa = mantissa * 10 + (uint64_t) (*p - '0');
+                fraction++;
+            }
+            digits++;
+            p++;
+        }
+    }
+    if (digits == 0)
+        return NULL;
+    if (p == end || isSpace(*p)){
+        if (digits < 19 && mantissa <= (UINT64_C(1) << 53) && fraction <= 22){
+            *value = (double) mantissa / powersOfTen[fraction];
+            if (negative)
+                *value = -*value;
+            return p;
+        }
+    } else if (*p != 'e' && *p != 'E')
+        return NULL;
+
+    char token[64];
+    while (p < end && !isSpace(*p))
+        p++;
+    if (p - start >= (long) sizeof(token))
+        return NULL;
+    memcpy(token, start, p - start);
+    token[p - start] = '\0';
+    char *tokenEnd;
+    *value = strtod(token, &tokenEnd);
+    if (*tokenEnd != '\0')
+        return NULL;
+    return p;
+}
+
+/*
+ * szak.txt line: number, first vertex, second vertex, distance
+ * @param context is the number of vertexes
+ *
+ * @date 2026.10.19.
+ */
+static bool parseEdge(const char *line, const char *end, void *record, const void *context){
+    int size = *(const int*) context;
+    Edge *edge = (Edge*) record;
+    int num;
+    line = parseInteger(line, end, &num);
+    if (line != NULL)
+        line = parseInteger(line, end, &edge->first);
+    if (line != NULL)
+        line = parseInteger(line, end, &edge->second);
+    if (line != NULL)
+        line = parseNumber(line, end, &edge->weight);
+    if (line == NULL || skipSpaces(line, end) != end)
+        return false;
+    if (edge->first < 1 || edge->first > size || edge->second < 1 || edge->second > size || !(edge->weight >= 0))
+        return false;
+    edge->first--;
+    edge->second--;
+    return true;
+}
+
+/*
+ * csp.txt line: number, name, x, y
+ * @param context is the largest number of a place
+ *
+ * @date 2026.10.19.
+ */
+static bool parsePlace(const char *line, const char *end, void *record, const void *context){
+    int maxNum = *(const int*) context;
+    Location *place = (Location*) record;
+    line = parseInteger(line, end, &place->num);
+    if (line == NULL || place->num < 1 || place->num > maxNum)
+        return false;
+    line = skipSpaces(line, end);
+    const char *name = line;
+    while (line < end && !isSpace(*line))
+        line++;
+    if (line == name || line - name >= (long) sizeof(place->name))
+        return false;
+    memcpy(place->name, name, line - name);
+    place->name[line - name] = '\0';
+    line = parseNumber(line, end, &place->x);
+    if (line != NULL)
+        line = parseNumber(line, end, &place->y);
+    return line != NULL && skipSpaces(line, end) == end;
+}
+
+/*
+ * hatar.txt line: x, y
+ *
+ * @date 2026.10.19.
+ */
+static bool parseCoordinate(const char *line, const char *end, void *record, const void *context){
+    (void) context;
+    double *coordinate = (double*) record;
+    line = parseNumber(line, end, &coordinate[0]);
+    if (line != NULL)
+        line = parseNumber(line, end, &coordinate[1]);
+    return line != NULL && skipSpaces(line, end) == end;
+}
+
+/*
+ * One worker: parses the lines of its chunk, the malformed ones are counted and skipped
+ * @param data is the chunk
+ *
+ * @date 2026.10.19.
+ */
+static int parseChunk(void *data){
+    Chunk *chunk = (Chunk*) data;
+    const char *line = chunk->begin;
+    while (line < chunk->end){
+        const char *end = (const char*) memchr(line, '\n', chunk->end - line);
+        if (end == NULL)
+            end = chunk->end;
+        if (skipSpaces(line, end) != end){
+            if (!reserveRecords(&chunk->records, 1)){
+                chunk->failed = true;
+                return 1;
+            }
+            void *record = chunk->records.values + chunk->records.count * chunk->records.recordSize;
+            if (chunk->parse(line, end, record, chunk->context))
+                chunk->records.count++;
+            else {
+                if (chunk->malformed < REPORTED_LINES)
+                    chunk->reported[chunk->malformed] = chunk->lines;
+                chunk->malformed++;
+            }
+        }
+        chunk->lines++;
+        line = end + 1;
+    }
+    return 0;
+}
+
+/*
+ * Runs the function on every job, the first job on the calling thread
+ * If a thread cannot be created, its job is run on the calling thread too.
+ * @param threads is the number of jobs
+ * @param jobs is the array of the jobs, jobSize is the size of one
+ *
+ * @date 2026.10.19.
+ */
+static void runParallel(int threads, SDL_ThreadFunction function, void *jobs, size_t jobSize){
+    SDL_Thread *workers[threads];
+    for (int i = 1; i < threads; ++i) {
+        workers[i] = SDL_CreateThread(function, "ingest", (char*) jobs + i * jobSize);
+        if (workers[i] == NULL)
+            function((char*) jobs + i * jobSize);
+    }
+    function(jobs);
+    for (int i = 1; i < threads; ++i) {
+        if (workers[i] != NULL)
+            SDL_WaitThread(workers[i], NULL);
+    }
+}
+
+/*
+ * Parses the complete lines of a block with the threads, then appends their records to the result
+ * @param buffer and length are the lines of the block
+ * @param report gets the lines and the malformed lines of the block added to it
+ * @return false if unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+static bool parseBlock(const char *buffer, size_t length, Chunk *chunks, int threads,
+                       RecordArray *result, IngestReport *report){
+    const char *begin = buffer;
+    for (int i = 0; i < threads; ++i) {
+        const char *end = buffer + length * (i + 1) / threads;
+        if (end < begin)
+            end = begin;
+        //The chunk ends after a new line
+        if (i < threads - 1){
+            const char *newLine = (const char*) memchr(end, '\n', buffer + length - end);
+            end = newLine == NULL ? buffer + length : newLine + 1;
+        }
+        chunks[i].begin = begin;
+        chunks[i].end = end;
+        chunks[i].records.count = 0;
+        chunks[i].lines = 0;
+        chunks[i].malformed = 0;
+        begin = end;
+    }
+    runParallel(threads, parseChunk, chunks, sizeof(Chunk));
+
+    for (int i = 0; i < threads; ++i) {
+        Chunk *chunk = &chunks[i];
+        if (chunk->failed || !reserveRecords(result, chunk->records.count))
+            return false;
+        memcpy(result->values + result->count * result->recordSize, chunk->records.values,
+               chunk->records.count * result->recordSize);
+        result->count += chunk->records.count;
+        for (long long j = 0; j < chunk->malformed && report->malformed + j < REPORTED_LINES; ++j)
+            report->malformedLines[report->malformed + j] = report->lines + chunk->reported[j] + 1;
+        report->malformed += chunk->malformed;
+        report->lines += chunk->lines;
+    }
+    return true;
+}
+
+/*
+ * Reads a file block by block, and parses its lines with several threads
+ * @param filename is the path of the file
+ * @param recordSize is the size of the record of one line
+ * @param parse parses one line, it returns false for malformed lines
+ * @param context is given to parse
+ * @param threads is the number of threads used (less than 1: number of CPUs)
+ * @param result gets the records in the order of the lines
+ * @param report gets the size of the file, the number of lines and the malformed lines, it may be NULL
+ * @return false if the file cannot be read or unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+static bool ingestFile(const char *filename, size_t recordSize, LineParser parse, const void *context, int threads,
+                       RecordArray *result, IngestReport *report){
+    FILE *fp;
+    fp = fopen(filename, "rb");
+
+    //Error handling
+    if (fp == NULL){
+        printf("Error with opening file: %s", filename);
+        return false;
+    }
+    if (threads < 1)
+        threads = SDL_GetCPUCount();
+
+    IngestReport counts;
+    memset(&counts, 0, sizeof(counts));
+    result->values = NULL;
+    result->count = result->capacity = 0;
+    result->recordSize = recordSize;
+    size_t capacity = BLOCK_SIZE;
+    char *buffer = (char*) malloc(capacity);
+    Chunk *chunks = (Chunk*) malloc(threads * sizeof(Chunk));
+    bool success = buffer != NULL && chunks != NULL;
+    for (int i = 0; success && i < threads; ++i) {
+        chunks[i].parse = parse;
+        chunks[i].context = context;
+        chunks[i].records.values = NULL;
+        chunks[i].records.count = chunks[i].records.capacity = 0;
+        chunks[i].records.recordSize = recordSize;
+        chunks[i].failed = false;
+    }
+
+    size_t carry = 0;
+    while (success){
+        size_t got = fread(buffer + carry, 1, capacity - carry, fp);
+        size_t length = carry + got;
+        bool endOfFile = got < capacity - carry;
+        if (endOfFile && ferror(fp)){
+            printf("Error with reading file: %s", filename);
+            success = false;
+            break;
+        }
+        counts.bytes += (long long) got;
+        //The block is parsed until its last new line, the rest is the beginning of the next block
+        size_t complete = length;
+        if (!endOfFile){
+            while (complete > 0 && buffer[complete - 1] != '\n')
+                complete--;
+            if (complete == 0){
+                //A line longer than the buffer
+                char *bigger = (char*) realloc(buffer, capacity * 2);
+                if (bigger == NULL){
+                    success = false;
+                    break;
+                }
+                buffer = bigger;
+                capacity *= 2;
+                carry = length;
+                continue;
+            }
+        }
+        success = parseBlock(buffer, complete, chunks, threads, result, &counts);
+        if (endOfFile)
+            break;
+        carry = length - complete;
+        memmove(buffer, buffer + complete, carry);
+    }
+
+    for (int i = 0; chunks != NULL && i < threads; ++i)
+        free(chunks[i].records.values);
+    free(chunks);
+    free(buffer);
+    fclose(fp);
+    if (!success){
+        free(result->values);
+        result->values = NULL;
+        return false;
+    }
+    if (report != NULL)
+        *report = counts;
+    return true;
+}
+
+/*
+ * Reads the edges of a szak.txt style file
+ * @param filename is the path of the file
+ * @param size is the number of vertexes, lines with other vertexes are malformed
+ * @param threads is the number of threads used (less than 1: number of CPUs)
+ * @param edges gets the edges in the order of the lines, the vertexes are numbered from 0
+ * @param report gets the size of the file, the number of lines and the malformed lines, it may be NULL
+ * @return false if the file cannot be read or unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+bool ingestEdges(const char *filename, int size, int threads, EdgeList *edges, IngestReport *report){
+    RecordArray records;
+    if (!ingestFile(filename, sizeof(Edge), parseEdge, &size, threads, &records, report))
+        return false;
+    edges->count = (int) records.count;
+    edges->values = (Edge*) records.values;
+    return true;
+}
+
+typedef struct{
+    const Edge *edges;
+    int first, last;        //the range of edges of the thread
+    int *counts;            //the thread's number of neighbours per vertex, then its next place in the lists
+    AdjacencyList *adjacency;
+}AdjacencyJob;
+
+/*
+ * First pass: counting the neighbours of the vertexes in the thread's range of edges
+ * An edge with 0 distance is not an edge, the same as in buildAdjacency
+ *
+ * @date 2026.10.19.
+ */
+static int countNeighbours(void *data){
+    AdjacencyJob *job = (AdjacencyJob*) data;
+    for (int i = job->first; i < job->last; ++i) {
+        const Edge *edge = &job->edges[i];
+        if (edge->weight == 0)
+            continue;
+        job->counts[edge->first]++;
+        if (edge->second != edge->first)
+            job->counts[edge->second]++;
+    }
+    return 0;
+}
+
+/*
+ * Second pass: the thread writes the neighbours of its edges to its own places in the lists, in the order
+ * of the lines
+ *
+ * @date 2026.10.19.
+ */
+static int fillNeighbours(void *data){
+    AdjacencyJob *job = (AdjacencyJob*) data;
+    AdjacencyList *adjacency = job->adjacency;
+    for (int i = job->first; i < job->last; ++i) {
+        const Edge *edge = &job->edges[i];
+        if (edge->weight == 0)
+            continue;
+        int place = job->counts[edge->first]++;
+        adjacency->targets[place] = edge->second;
+        adjacency->weights[place] = edge->weight;
+        if (edge->second != edge->first){
+            place = job->counts[edge->second]++;
+            adjacency->targets[place] = edge->first;
+            adjacency->weights[place] = edge->weight;
+        }
+    }
+    return 0;
+}
+
+/*
+ * Builds the neighbour lists of the undirected edges with several threads, in two passes over the edges
+ * Every thread counts the neighbours in its range of edges into its own counters. The prefix sum of the counters
+ * in the order of the vertexes, then of the threads gives every thread its own places in every list, so in the
+ * second pass the threads fill the lists without atomics, and the lists keep the order of the lines with any
+ * number of threads. The edges are kept during the build: the file is read in blocks, so the lists cannot be
+ * placed before the last line is read. Apart from the lists threads * size counters are allocated.
+ * @param edges are the edges, the vertexes are numbered from 0
+ * @param size is the number of vertexes
+ * @param threads is the number of threads used (less than 1: number of CPUs)
+ * @param adjacency gets the neighbour lists
+ * @return false if unable to allocate memory or there are too many edges
+ *
+ * @date 2026.10.19.
+ */
+bool edgesToAdjacency(const EdgeList *edges, int size, int threads, AdjacencyList *adjacency){
+    if (threads < 1)
+        threads = SDL_GetCPUCount();
+    if (threads > edges->count / 4096 + 1)
+        threads = edges->count / 4096 + 1;
+
+    adjacency->size = size;
+    adjacency->offsets = (int*) malloc((size + 1) * sizeof(int));
+    adjacency->targets = NULL;
+    adjacency->weights = NULL;
+    int *counts = (int*) calloc((size_t) threads * size, sizeof(int));
+    AdjacencyJob *jobs = (AdjacencyJob*) malloc(threads * sizeof(AdjacencyJob));
+    if (adjacency->offsets == NULL || (counts == NULL && size != 0) || jobs == NULL){
+        free(counts);
+        free(jobs);
+        freeAdjacency(adjacency);
+        return false;
+    }
+    for (int i = 0; i < threads; ++i) {
+        jobs[i].edges = edges->values;
+        jobs[i].first = (int) ((long long) edges->count * i / threads);
+        jobs[i].last = (int) ((long long) edges->count * (i + 1) / threads);
+        jobs[i].counts = counts + (size_t) i * size;
+        jobs[i].adjacency = adjacency;
+    }
+    runParallel(threads, countNeighbours, jobs, sizeof(AdjacencyJob));
+
+    long long count = 0;
+    for (int v = 0; v < size; ++v) {
+        adjacency->offsets[v] = (int) count;
+        for (int i = 0; i < threads; ++i) {
+            int neighbours = jobs[i].counts[v];
+            jobs[i].counts[v] = (int) count;
+            count += neighbours;
+        }
+        if (count > INT_MAX)
+            break;
+    }
+    bool success = count <= INT_MAX;
+    if (success){
+        adjacency->offsets[size] = (int) count;
+        adjacency->targets = (int*) malloc(count * sizeof(int));
+        adjacency->weights = (double*) malloc(count * sizeof(double));
+        success = (adjacency->targets != NULL && adjacency->weights != NULL) || count == 0;
+    }
+    if (!success){
+        free(counts);
+        free(jobs);
+        freeAdjacency(adjacency);
+        return false;
+    }
+    runParallel(threads, fillNeighbours, jobs, sizeof(AdjacencyJob));
+
+    free(counts);
+    free(jobs);
+    return true;
+}
+
+/*
+ * Reads a szak.txt style file straight into neighbour lists, without the adjacency matrix
+ * @param filename is the path of the file
+ * @param size is the number of vertexes, lines with other vertexes are malformed
+ * @param threads is the number of threads used (less than 1: number of CPUs)
+ * @param adjacency gets the neighbour lists
+ * @param report gets the size of the file, the number of lines and the malformed lines, it may be NULL
+ * @return false if the file cannot be read or unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+bool ingestGraph(const char *filename, int size, int threads, AdjacencyList *adjacency, IngestReport *report){
+    EdgeList edges;
+    if (!ingestEdges(filename, size, threads, &edges, report))
+        return false;
+    bool success = edgesToAdjacency(&edges, size, threads, adjacency);
+    free(edges.values);
+    return success;
+}
+
+/*
+ * Reads the places of a csp.txt style file, the coordinates are not converted to pixels
+ * @param filename is the path of the file
+ * @param maxNum is the largest number of a place, lines with larger numbers are malformed, so one wrong number
+ *        cannot make the array too large to allocate
+ * @param threads is the number of threads used (less than 1: number of CPUs)
+ * @param position gets the places, position->values[num-1] is the place numbered num (num is 0 if there is no such place)
+ * @param report gets the size of the file, the number of lines and the malformed lines, it may be NULL
+ * @return false if the file cannot be read or unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+bool ingestPlaces(const char *filename, int maxNum, int threads, Position *position, IngestReport *report){
+    RecordArray records;
+    if (!ingestFile(filename, sizeof(Location), parsePlace, &maxNum, threads, &records, report))
+        return false;
+    const Location *places = (const Location*) records.values;
+    int size = 0;
+    for (size_t i = 0; i < records.count; ++i) {
+        if (places[i].num > size)
+            size = places[i].num;
+    }
+    position->size = size;
+    position->values = (Location*) calloc(size, sizeof(Location));
+    if (position->values == NULL && size != 0){
+        free(records.values);
+        return false;
+    }
+    //The last line of a number wins, the same as in readPosition
+    for (size_t i = 0; i < records.count; ++i)
+        position->values[places[i].num - 1] = places[i];
+    free(records.values);
+    return true;
+}
+
+/*
+ * Reads the points of a hatar.txt style file
+ * @param filename is the path of the file
+ * @param threads is the number of threads used (less than 1: number of CPUs)
+ * @param coordinates gets the x and y of the points after each other
+ * @param count gets the number of points
+ * @param report gets the size of the file, the number of lines and the malformed lines, it may be NULL
+ * @return false if the file cannot be read or unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+bool ingestCoordinates(const char *filename, int threads, double **coordinates, int *count, IngestReport *report){
+    RecordArray records;
+    if (!ingestFile(filename, 2 * sizeof(double), parseCoordinate, NULL, threads, &records, report))
+        return false;
+    *coordinates = (double*) records.values;
+    *count = (int) records.count;
+    return true;
+}
+
+/*
+ * Prints the malformed lines of a file, nothing if there were none
+ * @param filename is the path of the file
+ * @param report is the report of the reading
+ *
+ * @date 2026.10.19.
+ */
+void printIngestReport(const char *filename, const IngestReport *report){
+    for (int i = 0; i < report->malformed && i < REPORTED_LINES; ++i)
+        printf("Malformed line skipped: %s:%lld\n", filename, report->malformedLines[i]);
+    if (report->malformed > REPORTED_LINES)
+        printf("%lld malformed lines skipped in %s\n", report->malformed, filename);
+}
@@ -0,0 +1,38 @@
+//
+// Created by Mark on 10/19/2026
+//
+
+#include <stdbool.h>
+#include "managefile.h"
+#include "managegraph.h"
+
+#ifndef INGEST_H
+#define INGEST_H
+
+typedef struct{
+    int first, second;  //vertexes from 0
+    double weight;
+}Edge;
+
+typedef struct{
+    int count;
+    Edge *values;
+}EdgeList;
+
+#define REPORTED_LINES 10   //the number of malformed lines whose line number is kept
+
+typedef struct{
+    long long bytes;
+    long long lines;
+    long long malformed;                    //number of skipped lines
+    long long malformedLines[REPORTED_LINES]; //line numbers of the first skipped lines, from 1
+}IngestReport;
+
+bool ingestEdges(const char *filename, int size, int threads, EdgeList *edges, IngestReport *report);
+bool edgesToAdjacency(const EdgeList *edges, int size, int threads, AdjacencyList *adjacency);
+bool ingestGraph(const char *filename, int size, int threads, AdjacencyList *adjacency, IngestReport *report);
+bool ingestPlaces(const char *filename, int maxNum, int threads, Position *position, IngestReport *report);
+bool ingestCoordinates(const char *filename, int threads, double **coordinates, int *count, IngestReport *report);
+void printIngestReport(const char *filename, const IngestReport *report);
+
+#endif //INGEST_H
@@ -0,0 +1,193 @@
+//
+// Created by Mark on 10/19/2026
+//
+// Isochrones: the places within a given distance, with a search which stops at the distance budget
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <float.h>
+#include <SDL2/SDL.h>
+
+#include "isochrone.h"
+#include "managefile.h"
+#include "managegraph.h"
+#include "minheap.h"
+#include "../debugmalloc.h"
+
+/*
+ * @param space is the working memory to initialize
+ * @param size is the number of vertexes of the graph
+ * @return false if unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+bool initSearchSpace(SearchSpace *space, int size){
+    space->size = size;
+    space->touchedCount = 0;
+    space->dist = (double*) malloc(size * sizeof(double));
+    space->touched = (int*) malloc(size * sizeof(int));
+    if (space->dist == NULL || space->touched == NULL || !initHeap(&space->heap, 64)){
+        free(space->dist);
+        free(space->touched);
+        return false;
+    }
+    for (int i = 0; i < size; ++i)
+        space->dist[i] = DBL_MAX;
+    return true;
+}
+
+void freeSearchSpace(SearchSpace *space){
+    free(space->dist);
+    free(space->touched);
+    freeHeap(&space->heap);
+}
+
+/*
+ * Dijkstra search which does not go further than the budget
+ * @param adjacency is the graph as neighbour lists
+ * @param space is the working memory, it must be initialized for the graph's size
+ * @param startPoint of the search
+ * @param budget is the largest distance
+ * @param reachable gets the vertexes within the budget in increasing order of distance, with the distances
+ * @return false if unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+bool reachableWithin(const AdjacencyList *adjacency, SearchSpace *space, int startPoint, double budget, ReachableSet *reachable){
+    //Resetting what the previous search touched
+    for (int i = 0; i < space->touchedCount; ++i)
+        space->dist[space->touched[i]] = DBL_MAX;
+    space->touchedCount = 0;
+    space->heap.size = 0;
+
+    int capacity = 16;
+    reachable->count = 0;
+    reachable->vertexes = (int*) malloc(capacity * sizeof(int));
+    reachable->dists = (double*) malloc(capacity * sizeof(double));
+    if (reachable->vertexes == NULL || reachable->dists == NULL){
+        freeReachableSet(reachable);
+        return false;
+    }
+    if (budget < 0)
+        return true;
+
+    space->dist[startPoint] = 0;
+    space->touched[space->touchedCount++] = startPoint;
+    if (!pushHeap(&space->heap, 0, startPoint)){
+        freeReachableSet(reachable);
+        return false;
+    }
+    while (space->heap.size > 0){
+        HeapItem item = popHeap(&space->heap);
+        if (item.key > space->dist[item.vertex])
+            continue;
+        //The vertexes come in increasing order, so the first one over the budget ends the search
+        if (item.key > budget)
+            break;
+        if (reachable->count == capacity){
+            capacity *= 2;
+            int *vertexes = (int*) realloc(reachable->vertexes, capacity * sizeof(int));
+            if (vertexes == NULL){
+                freeReachableSet(reachable);
+                return false;
+            }
+            reachable->vertexes = vertexes;
+            double *dists = (double*) realloc(reachable->dists, capacity * sizeof(double));
+            if (dists == NULL){
+                freeReachableSet(reachable);
+                return false;
+            }
+            reachable->dists = dists;
+        }
+        reachable->vertexes[reachable->count] = item.vertex;
+        reachable->dists[reachable->count] = item.key;
+        reachable->count++;
+
+        for (int e = adjacency->offsets[item.vertex]; e < adjacency->offsets[item.vertex + 1]; ++e) {
+            int next = adjacency->targets[e];
+            double weight = item.key + adjacency->weights[e];
+            if (weight <= budget && weight < space->dist[next]){
+                if (space->dist[next] == DBL_MAX)
+                    space->touched[space->touchedCount++] = next;
+                space->dist[next] = weight;
+                if (!pushHeap(&space->heap, weight, next)){
+                    freeReachableSet(reachable);
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void freeReachableSet(ReachableSet *reachable){
+    free(reachable->vertexes);
+    free(reachable->dists);
+    reachable->vertexes = NULL;
+    reachable->dists = NULL;
+    reachable->count = 0;
+}
+
+/*
+ * @return positive if o -> a -> b turns to the left, negative if to the right, 0 if they are on a line
+ */
+static long cross(Sint16 ox, Sint16 oy, Sint16 ax, Sint16 ay, Sint16 bx, Sint16 by){
+    return (long) (ax - ox) * (by - oy) - (long) (ay - oy) * (bx - ox);
+}
+
+static int comparePoints(const void *a, const void *b){
+    const Sint16 *first = (const Sint16*) a;
+    const Sint16 *second = (const Sint16*) b;
+    if (first[0] != second[0])
+        return first[0] - second[0];
+    return first[1] - second[1];
+}
+
+/*
+ * The region of the reachable places as a polygon in window coordinates: the convex hull of the places
+ * (monotone chain algorithm)
+ * @param reachable is the result of reachableWithin
+ * @param position is the vertex array
+ * @param windowY is the height of the window
+ * @param region gets the polygon like the border, free its x and y arrays. Less than 3 points: nothing to draw.
+ * @return false if unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+bool reachableRegion(const ReachableSet *reachable, const Position position, int windowY, Border *region){
+    int count = reachable->count;
+    Sint16 (*points)[2] = malloc((count > 0 ? count : 1) * sizeof(*points));
+    region->x = (Sint16*) malloc((2 * count + 1) * sizeof(Sint16));
+    region->y = (Sint16*) malloc((2 * count + 1) * sizeof(Sint16));
+    if (points == NULL || region->x == NULL || region->y == NULL){
+        free(points);
+        free(region->x);
+        free(region->y);
+        return false;
+    }
+    for (int i = 0; i < count; ++i) {
+        points[i][0] = (Sint16) position.values[reachable->vertexes[i]].x;
+        points[i][1] = (Sint16) (windowY - position.values[reachable->vertexes[i]].y);
+    }
+    qsort(points, count, sizeof(*points), comparePoints);
+
+    //Lower hull from left to right, then upper hull from right to left
+    int size = 0;
+    for (int pass = 0; pass < 2; ++pass) {
+        int start = size;
+        for (int k = 0; k < count; ++k) {
+            int i = pass == 0 ? k : count - 1 - k;
+            while (size >= start + 2 && cross(region->x[size-2], region->y[size-2], region->x[size-1], region->y[size-1],
+                                             points[i][0], points[i][1]) <= 0)
+                size--;
+            region->x[size] = points[i][0];
+            region->y[size] = points[i][1];
+            size++;
+        }
+        //The last point of a half is the first point of the other half
+        size--;
+    }
+    region->size = size > 0 ? size : count;
+    free(points);
+    return true;
+}
@@ -0,0 +1,37 @@
+//
+// Created by Mark on 10/19/2026
+//
+
+#include <stdbool.h>
+#include "managefile.h"
+#include "managegraph.h"
+#include "minheap.h"
+
+#ifndef ISOCHRONE_H
+#define ISOCHRONE_H
+
+/*
+ * Working memory of the bounded searches, it is reused between them.
+ * Only the entries touched by a search are reset, so a small search does not cost as much as the graph's size.
+ */
+typedef struct{
+    int size;
+    double *dist;
+    int *touched;
+    int touchedCount;
+    MinHeap heap;
+}SearchSpace;
+
+typedef struct{
+    int count;
+    int *vertexes;
+    double *dists;
+}ReachableSet;
+
+bool initSearchSpace(SearchSpace *space, int size);
+void freeSearchSpace(SearchSpace *space);
+bool reachableWithin(const AdjacencyList *adjacency, SearchSpace *space, int startPoint, double budget, ReachableSet *reachable);
+void freeReachableSet(ReachableSet *reachable);
+bool reachableRegion(const ReachableSet *reachable, const Position position, int windowY, Border *region);
+
+#endif //ISOCHRONE_H
@@ -3,6 +3,7 @@
 #include <stdbool.h>
 #include <math.h>
 #include <limits.h>
+#include <string.h>
 #include <SDL2/SDL.h>
 #include <SDL2/SDL2_gfxPrimitives.h>
 #include <SDL2/SDL_ttf.h>
@@ -10,6 +11,14 @@
 #include "managefile.h"
 #include "managegraph.h"
 #include "drawui.h"
+#include "planthread.h"
+#include "benchmark.h"
+#include "hublabel.h"
+#include "placeindex.h"
+#include "uirecord.h"
+#include "routewriter.h"
+#include "isochrone.h"
+#include "alternatives.h"
 #include "../debugmalloc.h"
 
 
@@ -44,9 +53,8 @@ int vertexFromCoordinates(const Position position, int windowY, int x, int y) {
  * This function frees the graph, position and border
  *
 */
-void freeAll(Graph graph, Position position, Border border){
-    free(graph.values[0]);
-    free(graph.values);
+void freeAll(AdjacencyList *adjacency, Position position, Border border){
+    freeAdjacency(adjacency);
     free(position.values);
     free(border.x);
     free(border.y);
@@ -56,137 +64,674 @@ void freeAll(Graph graph, Position position, Border border){
  * Handle fatal errors: unable to draw UI, unable to write text to SDL, unable to open font ...
  * In case of these, the function frees the used memory, closes the SDL window and exits the program with error code 6.
 */
-void fatalError(Graph graph, Position position, Border border){
-    freeAll(graph, position, border);
+void fatalError(AdjacencyList *adjacency, Position position, Border border){
+    freeAll(adjacency, position, border);
     SDL_Quit();
     exit(404);
 }
 
+/*
+ * Stops every planner thread before the graph is freed
+ * @param planner is the running planner or NULL
+ * @param retired is the list of the cancelled planners
+ *
+ * @date 2026.10.19.
+*/
+void stopPlanners(Planner *planner, Planner *retired){
+    if (planner != NULL)
+        retired = cancelPlanning(planner, retired);
+    reapPlanners(retired, true);
+}
 
-int main(int argc, char *argv[]) {
-    const int windowY = 700;
-    const int windowX = 1500;
+/*
+ * Draws a leg of the route which was planned by the planner thread
+ * @param renderer SDL renderer
+ * @param windowY is the height of the window
+ * @param position is the vertex array
+ * @param leg is the planned leg, its route is freed here
+ * @param legs is the number of legs of the whole route
+ * @param distanceSum is the distance of the route so far, the leg's distance is added to it
+ * @return false if unable to write to the SDL window
+ *
+ * @date 2026.10.19.
+*/
+bool drawPlannedLeg(SDL_Renderer *renderer, int windowY, const Position position, PlannedLeg leg, int legs, double *distanceSum){
+    int *route = leg.route;
+    bool success = true;
+    if (route[0] != -1){
+        *distanceSum += leg.distance;
+        int j;
+        for (j=1; route[j] != -1; j++)
+            connectTwoPoints(renderer, windowY, position, route[j-1], route[j], (RGB) {255, 0, 0});
+        if (leg.leg == 1)
+            success = displayFirstRoute(renderer, position.values[route[j-1]]);
+        if (success){
+            if (leg.leg == legs)
+                success = displayRoute(renderer, leg.leg, position.values[route[0]], *distanceSum, "Végpont:"); //Endpoint
+            else
+                success = displayRoute(renderer, leg.leg, position.values[route[0]], *distanceSum, "Köztes pont:"); //Middle point
+        }
+    }
+    free(route);
+    return success;
+}
 
-    //set up SDL
-    SDL_Window *window;
-    SDL_Renderer *renderer;
-    sdl_init("Utvonaltervezo", windowX, windowY, &window, &renderer); //Route planner
-    TTF_Init();
 
-    //load data
+/*
+ * Redraws the search box with the typed text and the first place whose name begins with it
+ * @param renderer SDL renderer
+ * @param index is the index of the place names
+ * @param position is the vertex array
+ * @param query is the typed text
+ * @return false if unable to write to the SDL window
+ *
+ * @date 2026.10.19.
+*/
+bool showSearch(SDL_Renderer *renderer, const PlaceIndex *index, const Position position, const char *query){
+    if (query[0] == '\0')
+        return drawSearchBox(renderer, query, NULL);
+    char hint[100];
+    int first;
+    int count = findPlacesByPrefix(index, query, &first);
+    if (count == 0)
+        sprintf(hint, "Nincs találat"); //No match
+    else
+        sprintf(hint, "%s (%d találat)", position.values[index->sorted[first]].name, count); //matches
+    return drawSearchBox(renderer, query, hint);
+}
+
+/*
+ * The place chosen in the search box: the exact match of the text, or the first one beginning with it
+ * @return the vertex, -1 if there is no such place
+ *
+ * @date 2026.10.19.
+*/
+int searchedVertex(const PlaceIndex *index, const char *query){
+    if (query[0] == '\0')
+        return -1;
+    int vertex = findPlace(index, query);
+    int first;
+    if (vertex == -1 && findPlacesByPrefix(index, query, &first) > 0)
+        vertex = index->sorted[first];
+    return vertex;
+}
+
+/*
+ * Everything the event handling works on: the loaded data, the chosen points, the search box and the planners
+ */
+typedef struct{
+    SDL_Renderer *renderer;
+    int windowX, windowY;
     Position position;
     Border border;
-    Graph graph;
-    if (!readPosition(&position)){
-        exit(2);
+    AdjacencyList adjacency;    //the graph as neighbour lists, read straight from the file without the adjacency matrix
+    DataFiles files;        //where the data is loaded from
+    PlaceIndex index;
+    SearchSpace space;
+    char query[51];         //the places can be chosen by typing their name too
+    int numberOfChosen;
+    int *chosenpoints;
+    Uint32 plannerEvent;
+    Planner *planner;       //the route being planned
+    Planner *retired;       //cancelled planners whose thread is still running
+    double distanceSum;
+    RouteWriter *routes;    //the planned routes are written here too, NULL if they are not needed
+    RouteWriter *routeFile; //the writer of the routes, it is closed at the exit even after an error, NULL if there is none
+    bool canEdit;
+    bool quit;
+}Session;
+
+/*
+ * Where the time of handling an event went, in milliseconds
+ */
+typedef struct{
+    double picking;     //finding the vertex of a click or of the searched name
+    double planning;    //shortestRoute on the planner thread
+    double drawing;     //everything else done by the UI thread, mostly drawing
+}EventTiming;
+
+/*
+ * @param start is the value of SDL_GetPerformanceCounter at the start
+ * @return the milliseconds since then
+ *
+ * @date 2026.10.19.
+*/
+double millisecondsSince(Uint64 start){
+    return (double) (SDL_GetPerformanceCounter() - start) * 1000.0 / (double) SDL_GetPerformanceFrequency();
+}
+
+/*
+ * Frees what the session built from the loaded data, the planner threads are stopped first
+ *
+ * @date 2026.10.19.
+*/
+void freeSessionData(Session *session){
+    stopPlanners(session->planner, session->retired);
+    free(session->chosenpoints);
+    freeSearchSpace(&session->space);
+    freePlaceIndex(&session->index);
+}
+
+/*
+ * Finishes the file of the routes, so the routes written so far are kept
+ *
+ * @date 2026.10.19.
+*/
+void closeRoutes(Session *session){
+    if (session->routeFile != NULL && !closeRouteWriter(session->routeFile))
+        printf("Error with writing the routes");
+    session->routeFile = NULL;
+    session->routes = NULL;
+}
+
+/*
+ * Stops the program after a fatal error of drawUI or of handleEvent
+ *
+ * @date 2026.10.19.
+*/
+void sessionError(Session *session){
+    freeSessionData(session);
+    closeRoutes(session);
+    fatalError(&session->adjacency, session->position, session->border);
+}
+
+/*
+ * Loads the data files and draws the UI
+ * @param session gets the data, the renderer, the window size, the files and the route file must be set
+ * @return 0 on success, else the exit code of the error
+ *
+ * @date 2026.10.19.
+*/
+int startSession(Session *session){
+    if (!readPosition(&session->position, session->files.maxPlaces, session->files.places))
+        return 2;
+    if (!readAdjacency(&session->adjacency, session->position.size, session->files.graph)){
+        free(session->position.values);
+        return 3;
     }
-    graph.size = position.size;
-    graph.values = initGraph(graph.size);
-    if (graph.values == NULL){
-        free(position.values);
-        exit(3);
+    if (!readBorder(&session->border, session->windowY, session->files.border)){
+        free(session->position.values);
+        freeAdjacency(&session->adjacency);
+        return 4;
     }
-    if (!readBorder(&border, windowY)){
-        free(position.values);
+    if (!buildPlaceIndex(session->position, &session->index)){
+        freeAll(&session->adjacency, session->position, session->border);
+        return 5;
+    }
+    if (!initSearchSpace(&session->space, session->adjacency.size)){
+        freePlaceIndex(&session->index);
+        freeAll(&session->adjacency, session->position, session->border);
+        return 5;
+    }
+
+    session->query[0] = '\0';
+    session->numberOfChosen = 0;
+    session->chosenpoints = (int*) malloc(session->numberOfChosen * sizeof(int));
+
+    /*
+     * The route is planned on a separate thread, so the window is not frozen by long computations.
+     * The thread sends a plannerEvent when a leg is ready, then the leg is drawn by handleEvent.
+     */
+    session->plannerEvent = SDL_RegisterEvents(1);
+    session->planner = NULL;
+    session->retired = NULL;
+    session->distanceSum = 0;
+    session->routes = session->routeFile;
+    session->canEdit = true;
+    session->quit = false;
+
+    if(!drawUI(session->renderer, session->windowX, session->windowY, session->position, &session->adjacency, session->border))
+        sessionError(session);
+    return 0;
+}
+
+/*
+ * Frees everything of the session, the planner threads are stopped first
+ *
+ * @date 2026.10.19.
+*/
+void endSession(Session *session){
+    freeSessionData(session);
+    freeAll(&session->adjacency, session->position, session->border);
+}
+
+/*
+ * Stops writing the routes after an error of the route writer, the planning goes on
+ *
+ * @date 2026.10.19.
+*/
+void stopWritingRoutes(Session *session){
+    printf("Error with writing the routes, it is stopped");
+    session->routes = NULL;
+}
+
+/*
+ * Handles a planner event: draws the legs which are ready
+ * @return false if unable to write to the SDL window or the planning failed
+ *
+ * @date 2026.10.19.
+*/
+bool handlePlannerEvent(Session *session, const SDL_Event *event, EventTiming *timing){
+    Planner *planner = session->planner;
+    if (planner != NULL && event->user.data1 == planner){
+        PlannedLeg leg;
+        bool legDrawn = false;
+        while (nextPlannedLeg(planner, &leg)){
+            timing->planning += leg.time;
+            if (session->routes != NULL && leg.route != NULL
+                && !addRouteLeg(session->routes, session->position, planner->points[leg.leg-1], planner->points[leg.leg], leg.route, leg.distance))
+                stopWritingRoutes(session);
+            if (leg.route == NULL || !drawPlannedLeg(session->renderer, session->windowY, session->position, leg, planner->legs, &session->distanceSum))
+                return false;
+            legDrawn = true;
+        }
+        if (legDrawn && !displayProgress(session->renderer, planner->consumed, planner->legs))
+            return false;
+        if (planningFinished(planner)){
+            if (session->routes != NULL && !endRoute(session->routes, session->position))
+                stopWritingRoutes(session);
+            freePlanner(planner);
+            session->planner = NULL;
+        }
+    }
+    session->retired = reapPlanners(session->retired, false);
+    return true;
+}
+
+/*
+ * Draws the region which can be reached within 50 km from the last chosen point
+ * @return false if unable to allocate memory
+ *
+ * @date 2026.10.19.
+*/
+bool showReachable(Session *session){
+    const double budget = 50;
+    if (session->numberOfChosen == 0)
+        return true;
+    ReachableSet reachable;
+    Border region;
+    int startPoint = session->chosenpoints[session->numberOfChosen-1];
+    if (!reachableWithin(&session->adjacency, &session->space, startPoint, budget, &reachable))
+        return false;
+    bool success = reachableRegion(&reachable, session->position, session->windowY, &region);
+    freeReachableSet(&reachable);
+    if (!success)
+        return false;
+    drawReachableRegion(session->renderer, region);
+    free(region.x);
+    free(region.y);
+    return true;
+}
+
+/*
+ * Draws the optimal route and at most two alternatives between the two chosen points, each in its own color
+ * @return false if unable to allocate memory or to write to the SDL window
+ *
+ * @date 2026.10.19.
+*/
+bool showAlternatives(Session *session){
+    const RGB colors[] = {{255, 0, 0}, {0, 0, 255}, {0, 160, 0}};
+    char *names[] = {"Piros:", "Kék:", "Zöld:"}; //Red, Blue, Green
+    const int k = sizeof(colors) / sizeof(colors[0]);
+    AlternativeRoute routes[sizeof(colors) / sizeof(colors[0])];
+    int from = session->chosenpoints[0];
+    int to = session->chosenpoints[1];
+    int found = alternativeRoutes(&session->adjacency, from, to, k, 1.3, 0.6, routes);
+    if (found == -1)
+        return false;
+    //The optimal route is drawn last, so it is on the top
+    for (int r = found - 1; r >= 0; --r) {
+        const int *route = routes[r].route;
+        for (int j = 1; route[j] != -1; ++j)
+            connectTwoPoints(session->renderer, session->windowY, session->position, route[j-1], route[j], colors[r]);
+    }
+    bool success = found == 0 || displayFirstRoute(session->renderer, session->position.values[from]);
+    for (int r = 0; r < found && success; ++r)
+        success = displayRoute(session->renderer, r + 1, session->position.values[to], routes[r].distance, names[r]);
+    freeAlternativeRoutes(routes, found);
+    return success;
+}
+
+/*
+ * Handles a click on the buttons or on the map
+ * @param x and y are the coordinates of the click
+ * @return false if unable to write to the SDL window or to start the planning
+ *
+ * @date 2026.10.19.
+*/
+bool handleClick(Session *session, int x, int y, EventTiming *timing){
+    if (x >= 1200 && x <= 1450){
+        if (y >= 100 && y <= 150){
+            //New route button is pushed, the route being planned is not needed anymore
+            if (session->planner != NULL){
+                session->retired = cancelPlanning(session->planner, session->retired);
+                session->planner = NULL;
+            }
+            if(!drawUI(session->renderer, session->windowX, session->windowY, session->position, &session->adjacency, session->border))
+                return false;
+            SDL_RenderPresent(session->renderer);
+            session->query[0] = '\0';
+            free(session->chosenpoints);
+            session->numberOfChosen = 0;
+            session->chosenpoints = (int*) malloc(session->numberOfChosen * sizeof(int));
+            session->canEdit = true;
+        }
+        else if (y >= 170 && y <= 220 && session->canEdit){
+            //Planing button is pushed
+            if (session->numberOfChosen >= 2){
+                session->planner = startPlanning(&session->adjacency, session->chosenpoints, session->numberOfChosen, session->plannerEvent);
+                if (session->planner == NULL || !displayProgress(session->renderer, 0, session->numberOfChosen-1))
+                    return false;
+                if (session->routes != NULL)
+                    beginRoute(session->routes);
+                session->distanceSum = 0;
+                session->numberOfChosen = 0;
+                free(session->chosenpoints);
+                session->chosenpoints = (int*) malloc(session->numberOfChosen * sizeof(int));
+                session->canEdit = false;
+            }
+        }
+        else if (y >= 510 && y <= 560 && session->canEdit){
+            //Alternatives button is pushed
+            if (session->numberOfChosen == 2){
+                if (!showAlternatives(session))
+                    return false;
+                session->numberOfChosen = 0;
+                free(session->chosenpoints);
+                session->chosenpoints = (int*) malloc(session->numberOfChosen * sizeof(int));
+                session->canEdit = false;
+            }
+        }
+        else if (y >= 580 && y <= 630 && session->canEdit){
+            //Reachable button is pushed
+            if (!showReachable(session))
+                return false;
+        }
+    } else if (session->canEdit) {
+        Uint64 start = SDL_GetPerformanceCounter();
+        int vertex = vertexFromCoordinates(session->position, session->windowY, x, y);
+        timing->picking += millisecondsSince(start);
+        if (vertex != -1)
+            session->chosenpoints = vertexesChosen(session->renderer, session->windowY, session->position, vertex, session->chosenpoints, &session->numberOfChosen);
+    }
+    return true;
+}
+
+/*
+ * Handles an event of the user or of the planner thread
+ * @param session is the state of the program, session->quit is set when the window is closed
+ * @param event is the SDL event
+ * @param timing gets the time spent on the event added to it
+ * @return false on fatal errors
+ *
+ * @date 2026.10.19.
+*/
+bool handleEvent(Session *session, const SDL_Event *event, EventTiming *timing){
+    Uint64 start = SDL_GetPerformanceCounter();
+    double picking = timing->picking;
+    bool success = true;
+    bool searchChanged = false;
+    bool searchChosen = false;
+
+    if (event->type == session->plannerEvent)
+        success = handlePlannerEvent(session, event, timing);
+    else switch (event->type){
+    case SDL_QUIT:
+        session->quit = true;
+        break;
+    case SDL_MOUSEBUTTONDOWN:
+        if (event->button.button == SDL_BUTTON_LEFT)
+            success = handleClick(session, event->button.x, event->button.y, timing);
+        break;
+    case SDL_TEXTINPUT:
+        if (strlen(session->query) + strlen(event->text.text) < sizeof(session->query)){
+            strcat(session->query, event->text.text);
+            searchChanged = true;
+        }
+        break;
+    case SDL_KEYDOWN:
+        if (event->key.keysym.sym == SDLK_BACKSPACE && session->query[0] != '\0'){
+            //Removing the whole last UTF-8 character
+            int length = (int) strlen(session->query);
+            do {
+                length--;
+            } while (length > 0 && (session->query[length] & 0xC0) == 0x80);
+            session->query[length] = '\0';
+            searchChanged = true;
+        } else if (event->key.keysym.sym == SDLK_RETURN || event->key.keysym.sym == SDLK_KP_ENTER)
+            searchChosen = true;
+        break;
+    }
+    if (searchChosen){
+        Uint64 pickingStart = SDL_GetPerformanceCounter();
+        int vertex = searchedVertex(&session->index, session->query);
+        timing->picking += millisecondsSince(pickingStart);
+        if (vertex != -1 && session->canEdit){
+            session->chosenpoints = vertexesChosen(session->renderer, session->windowY, session->position, vertex, session->chosenpoints, &session->numberOfChosen);
+            session->query[0] = '\0';
+            searchChanged = true;
+        }
+    }
+    if (searchChanged && success)
+        success = showSearch(session->renderer, &session->index, session->position, session->query);
+
+    timing->drawing += millisecondsSince(start) - (timing->picking - picking);
+    return success;
+}
+
+/*
+ * Replays a recorded session without window, then writes how long each event took
+ * @param recording is the file made by --record
+ * @param report is the CSV file of the timings
+ * @param files are the data files
+ * @param windowX and windowY are the size of the UI
+ * @return 0 on success, else the exit code of the error
+ *
+ * @date 2026.10.19.
+*/
+int replaySession(const char *recording, const char *report, const DataFiles files, int windowX, int windowY){
+    FILE *input = openRecording(recording);
+    if (input == NULL)
+        return 6;
+    FILE *output = fopen(report, "w");
+    if (output == NULL){
+        printf("Error with opening file: %s", report);
+        fclose(input);
+        return 6;
+    }
+
+    //The UI is drawn to a surface, the drawing costs the same as in the window
+    SDL_Surface *surface;
+    Session session;
+    session.windowX = windowX;
+    session.windowY = windowY;
+    session.files = files;
+    session.routeFile = NULL;
+    sdl_init_offscreen(windowX, windowY, &surface, &session.renderer);
+    TTF_Init();
+    int error = startSession(&session);
+    if (error != 0){
+        fclose(input);
+        fclose(output);
+        return error;
+    }
+
+    fprintf(output, "event,time,type,x,y,picking_ms,planning_ms,drawing_ms\n");
+    EventTiming sum = {0, 0, 0};
+    RecordedEvent recorded;
+    SDL_Event event;
+    int count = 0;
+    while (!session.quit && readRecordedEvent(input, &recorded, &event)){
+        EventTiming timing = {0, 0, 0};
+        if (!handleEvent(&session, &event, &timing))
+            sessionError(&session);
+        //The route of a planning click belongs to the click, so the next event waits for it
+        while (session.planner != NULL){
+            SDL_Event plannerEvent;
+            SDL_WaitEvent(&plannerEvent);
+            if (plannerEvent.type == session.plannerEvent && !handleEvent(&session, &plannerEvent, &timing))
+                sessionError(&session);
+        }
+        const char *type = "quit";
+        if (recorded.type == SDL_MOUSEBUTTONDOWN)
+            type = "click";
+        else if (recorded.type == SDL_TEXTINPUT)
+            type = "text";
+        else if (recorded.type == SDL_KEYDOWN)
+            type = "key";
+        fprintf(output, "%d,%u,%s,%d,%d,%.3f,%.3f,%.3f\n", count, recorded.time, type, recorded.x, recorded.y,
+                timing.picking, timing.planning, timing.drawing);
+        sum.picking += timing.picking;
+        sum.planning += timing.planning;
+        sum.drawing += timing.drawing;
+        count++;
+    }
+    printf("Replayed %d events: picking %.3f ms, planning %.3f ms, drawing %.3f ms\n", count, sum.picking, sum.planning, sum.drawing);
+
+    fclose(input);
+    fclose(output);
+    endSession(&session);
+    SDL_DestroyRenderer(session.renderer);
+    SDL_FreeSurface(surface);
+    SDL_Quit();
+    return 0;
+}
+
+int main(int argc, char *argv[]) {
+    const int windowY = 700;
+    const int windowX = 1500;
+
+    /*
+     * Options of the data files, they can be used in every mode:
+     *  - --graph <file>: the roads instead of szak.txt
+     *  - --places <file>: the places instead of csp.txt
+     *  - --border <file>: the border instead of hatar.txt
+     *  - --max-places <n>: the largest number of a place (10000000), the places above it are malformed lines
+     * They are taken out of the arguments, the modes below see the rest.
+     */
+    DataFiles files = {"szak.txt", "csp.txt", "hatar.txt", MAX_PLACES};
+    char *args[argc];
+    int count = 0;
+    for (int i = 0; i < argc; ++i) {
+        if (i + 1 < argc && strcmp(argv[i], "--graph") == 0)
+            files.graph = argv[++i];
+        else if (i + 1 < argc && strcmp(argv[i], "--places") == 0)
+            files.places = argv[++i];
+        else if (i + 1 < argc && strcmp(argv[i], "--border") == 0)
+            files.border = argv[++i];
+        else if (i + 1 < argc && strcmp(argv[i], "--max-places") == 0){
+            files.maxPlaces = atoi(argv[++i]);
+            if (files.maxPlaces < 1){
+                printf("Wrong number of places: %s", argv[i]);
+                exit(2);
+            }
+        }
+        else
+            args[count++] = argv[i];
+    }
+    argc = count;
+    argv = args;
+
+    /*
+     * Modes without window:
+     *  - route_planner --bench <name>: runs a benchmark
+     *  - route_planner --hublabels <file>: builds the hub label index and writes it to the file
+     *  - route_planner --replay <file> [report]: replays a recorded session, the timings are written to report (replay.csv)
+     */
+    if (argc == 3 && strcmp(argv[1], "--bench") == 0){
+        //The benchmarks compare to dijkstraAlgorithm, so they need the adjacency matrix too
+        Position position;
+        Graph graph;
+        if (!readPosition(&position, files.maxPlaces, files.places))
+            exit(2);
+        graph.size = position.size;
+        graph.values = initGraph(graph.size, files.graph);
+        if (graph.values == NULL){
+            free(position.values);
+            exit(3);
+        }
+        bool success = runBenchmark(argv[2], graph, position, files);
         free(graph.values[0]);
         free(graph.values);
-        exit(4);
+        free(position.values);
+        return success ? 0 : 5;
+    }
+    if (argc == 3 && strcmp(argv[1], "--hublabels") == 0){
+        Position position;
+        AdjacencyList adjacency;
+        if (!readPosition(&position, files.maxPlaces, files.places))
+            exit(2);
+        if (!readAdjacency(&adjacency, position.size, files.graph)){
+            free(position.values);
+            exit(3);
+        }
+        bool success = buildHubLabelFile(argv[2], &adjacency);
+        freeAdjacency(&adjacency);
+        free(position.values);
+        return success ? 0 : 5;
+    }
+    if ((argc == 3 || argc == 4) && strcmp(argv[1], "--replay") == 0)
+        return replaySession(argv[2], argc == 4 ? argv[3] : "replay.csv", files, windowX, windowY);
+
+    /*
+     * Options of the window:
+     *  - --record <file>: the user's events are written to the file for --replay
+     *  - --routes <file>: the planned routes are written to the file, GeoJSON if it ends with .json or .geojson, else binary
+     */
+    FILE *recorder = NULL;
+    RouteWriter routes;
+    bool writeRoutes = false;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--record") == 0 && recorder == NULL){
+            recorder = startRecording(argv[i+1]);
+            if (recorder == NULL){
+                if (writeRoutes)
+                    closeRouteWriter(&routes);
+                exit(6);
+            }
+        } else if (strcmp(argv[i], "--routes") == 0 && !writeRoutes){
+            writeRoutes = openRouteWriter(&routes, argv[i+1], routeFormatOf(argv[i+1]));
+            if (!writeRoutes)
+                exit(6);
+        }
     }
 
-    if(!drawUI(renderer, windowX, windowY, position, graph, border))
-        fatalError(graph, position, border);
+    //set up SDL
+    SDL_Window *window;
+    Session session;
+    session.windowX = windowX;
+    session.windowY = windowY;
+    session.files = files;
+    session.routeFile = writeRoutes ? &routes : NULL;
+    sdl_init("Utvonaltervezo", windowX, windowY, &window, &session.renderer); //Route planner
+    TTF_Init();
 
-    int numberOfChosen = 0;
-    int *chosenpoints = (int*) malloc(numberOfChosen * sizeof(int));
+    //load data
+    int error = startSession(&session);
+    if (error != 0){
+        closeRoutes(&session);
+        exit(error);
+    }
+    SDL_StartTextInput();
 
-    bool quit = false;
-    bool click = false;
-    bool canEdit = true;
-    int x, y;
-    while (!quit){
+    Uint32 recordingStart = SDL_GetTicks();
+    while (!session.quit){
         SDL_Event event;
         SDL_WaitEvent(&event);
-        switch (event.type){
-        case SDL_QUIT:
-            quit = true;
-            break;
-        case SDL_MOUSEBUTTONDOWN:
-            if (event.button.button == SDL_BUTTON_LEFT){
-                click = true;
-                x = event.button.x;
-                y = event.button.y;
-            }
-            break;
-        }
-        if (click){
-            if (x >= 1200 && x <= 1450){
-                if (y >= 100 && y <= 150){
-                    //New route button is pushed
-                    if(!drawUI(renderer, windowX, windowY, position, graph, border))
-                        fatalError(graph, position, border);
-                    SDL_RenderPresent(renderer);
-                    if (numberOfChosen > 0)
-                        free(chosenpoints);
-                    numberOfChosen = 0;
-                    chosenpoints = (int*) malloc(numberOfChosen * sizeof(int));
-                    canEdit = true;
-                }
-                else if (y >= 170 && y <= 220 && canEdit){
-                    //Planing button is pushed
-                    if (numberOfChosen >= 2){
-                        double distanceCurrent;
-                        double distanceSum = 0;
-                        int *route = NULL;
-                        for (int i=1; i<numberOfChosen; ++i){
-                            route = dijkstraAlgorithm(graph, chosenpoints[i-1], chosenpoints[i], &distanceCurrent);
-                            if (route == NULL){
-                                free(chosenpoints);
-                                fatalError(graph, position, border);
-                            }
-                            if (route[0] != -1){
-                                distanceSum += distanceCurrent;
-                                int j;
-                                for (j=1; route[j] != -1; j++)
-                                    connectTwoPoints(renderer, windowY, position, route[j-1], route[j]);
-                                if (i == 1){
-                                    if(!displayFirstRoute(renderer, position.values[route[j-1]])){
-                                        free(route);
-                                        free(chosenpoints);
-                                        fatalError(graph, position, border);
-                                    }
-                                }
-                                if (i == numberOfChosen-1){
-                                    if(!displayRoute(renderer, i, position.values[route[0]], distanceSum, "Végpont:")){ //Endpoint
-                                        free(route);
-                                        free(chosenpoints);
-                                        fatalError(graph, position, border);
-                                    }
-                                }
-                                else{
-                                    if(!displayRoute(renderer, i, position.values[route[0]], distanceSum, "Köztes pont:")){ //Middle point
-                                        free(route);
-                                        free(chosenpoints);
-                                        fatalError(graph, position, border);
-                                    }
-                                }
-                                free(route);
-                            }
-                        }
-                        numberOfChosen = 0;
-                        free(chosenpoints);
-                        canEdit = false;
-                    }
-                }
-            } else if (canEdit) {
-                int vertex = vertexFromCoordinates(position, windowY, x, y);
-                if (vertex != -1)
-                    chosenpoints = vertexesChosen(renderer, windowY, position, vertex, chosenpoints, &numberOfChosen);
-            }
-            click = false;
+        if (recorder != NULL && !recordEvent(recorder, &event, SDL_GetTicks() - recordingStart)){
+            printf("Error with writing the recording, it is stopped");
+            fclose(recorder);
+            recorder = NULL;
         }
+        EventTiming timing = {0, 0, 0};
+        if (!handleEvent(&session, &event, &timing))
+            sessionError(&session);
     }
 
-    freeAll(graph, position, border);
+    if (recorder != NULL)
+        fclose(recorder);
+    closeRoutes(&session);
+    endSession(&session);
 
     SDL_Quit();
     return 0; // 0 => no error; else => error
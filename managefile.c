@@ -9,6 +9,7 @@
 #include <string.h>
 
 #include "managefile.h"
+#include "ingest.h"
 #include "../debugmalloc.h"
 
 /*
@@ -21,43 +22,54 @@
  * The coordinates of the Hungarian border line
  */
 
-typedef struct {
-    int num, first, second;
-    double weight;
-}GraphData;
-
 /* Read from szak.txt file, and fill the graph
  * @param graph is the graph filled with DBL_MAX
+ * @param filename is the path of the szak.txt style file
  * @return modified graph When there is a connection between two points, the value is the distance between them.
  *
  * graph[a][b] = graph[b][a]
+ * Malformed lines and lines with vertexes out of range are skipped and printed, they do not stop the reading.
  *
  * @date 2019.11.01.
  */
-bool readGraph(double **graph, const int size){
-    FILE *fp;
-    fp = fopen("szak.txt", "r");
-
-    //Error handling
-    if (fp == NULL){
-        printf("Error with opening file: szak.txt");
+bool readGraph(double **graph, const int size, const char *filename){
+    EdgeList edges;
+    IngestReport report;
+    if (!ingestEdges(filename, size, 0, &edges, &report))
         return false;
+    printIngestReport(filename, &report);
+    for (int i = 0; i < edges.count; ++i) {
+        Edge temp = edges.values[i];
+        graph[temp.first][temp.second] = temp.weight;
+        graph[temp.second][temp.first] = temp.weight;
     }
-    GraphData temp;
-    while (fscanf(fp, "%d %d %d %lf", &temp.num, &temp.first, &temp.second, &temp.weight) == 4){
-        if (temp.first <= size && temp.second <= size){
-            graph[temp.first - 1][temp.second - 1] = temp.weight;
-            graph[temp.second - 1][temp.first - 1] = temp.weight;
-        } else{
-            fclose(fp);
-            return false;
-        }
-    }
+    free(edges.values);
+    return true;
+}
 
-    fclose(fp);
+/* Read from szak.txt file straight into neighbour lists, without the adjacency matrix
+ * @param adjacency gets the neighbour lists of the undirected edges, free it with freeAdjacency
+ * @param size is the number of vertexes
+ * @param filename is the path of the szak.txt style file
+ * @return whether the file reading is successful or not
+ *
+ * Malformed lines and lines with vertexes out of range are skipped and printed, they do not stop the reading.
+ *
+ * @date 2026.10.19.
+ */
+bool readAdjacency(AdjacencyList *adjacency, const int size, const char *filename){
+    IngestReport report;
+    if (!ingestGraph(filename, size, 0, adjacency, &report))
+        return false;
+    printIngestReport(filename, &report);
     return true;
 }
 
+//The constants of dataManipulation, they are needed by originalCoordinates too
+static const int xRed = 418900; //Reduce x coord.
+static const int yRed = 36200; //Reduce y coord.
+static const double scale = 0.00211; //Squeeze
+
 /*
  * Converts the GPS coordinates to pixels in order to match a 1400x700 window (actual value: ~1100 x ~700)
  * @param x and y one point's coordinates
@@ -65,52 +77,41 @@ bool readGraph(double **graph, const int size){
  * @date 2019.11.12.
 */
 static void dataManipulation(double *x, double *y){
-    const int xRed = 418900; //Reduce x coord.
-    const int yRed = 36200; //Reduce y coord.
-    const double scale = 0.00211; //Squeeze
-
     *x -= xRed;
     *y -= yRed;
     *x *= scale;
     *y *= scale;
 }
 
+/*
+ * The coordinates of a place as they are in the file, the inverse of dataManipulation
+ * @param place is the place
+ * @param x and y get the coordinates
+ *
+ * @date 2026.10.19.
+*/
+void originalCoordinates(const Location place, double *x, double *y){
+    *x = place.x / scale + xRed;
+    *y = place.y / scale + yRed;
+}
+
 /* Read from csp.txt file, and put it into the position structure
+ * The array is as large as the largest number of a place. Places numbered above maxNum are malformed lines,
+ * they are skipped and printed.
  * @param position is the position array which is built here
+ * @param maxNum is the largest number of a place
+ * @param filename is the path of the csp.txt style file
  * @return whether the file reading is successful or not
  *
  * @date 2019.11.01.
  */
-bool readPosition(Position *position){
-    FILE *fp;
-    fp = fopen("csp.txt", "r");
-
-    //Error handling
-    if (fp == NULL){
-        printf("Error with opening file: csp.txt");
+bool readPosition(Position *position, const int maxNum, const char *filename){
+    IngestReport report;
+    if (!ingestPlaces(filename, maxNum, 0, position, &report))
         return false;
-    }
-
-    int maxlen = 0;
-    position->values = (Location*) malloc(0 * sizeof(Location));
-    Location temp;
-
-    while (fscanf(fp, "%d %s %lf %lf", &temp.num, temp.name, &temp.x, &temp.y) == 4){
-        dataManipulation(&temp.x, &temp.y);
-        if (temp.num > maxlen){
-            maxlen = temp.num;
-            Location* tempArray = (Location*) realloc(position->values, maxlen * sizeof(Location));
-            if (tempArray == NULL){
-                free(position->values);
-                return false;
-            }
-            position->values = tempArray;
-        }
-        position->values[temp.num-1] = temp;
-    }
-    position->size = maxlen;
-
-    fclose(fp);
+    printIngestReport(filename, &report);
+    for (int i = 0; i < position->size; ++i)
+        dataManipulation(&position->values[i].x, &position->values[i].y);
     return true;
 }
 
@@ -118,43 +119,35 @@ bool readPosition(Position *position){
  * The x and y coordinates are separated into two Sint16 arrays for the drawing function
  * @param border is the border structure where the data is stored
  * @param windowY is the height of the window
+ * @param filename is the path of the hatar.txt style file
  * @return logic variable which is false if the hatar.txt doesn't exist or unable to allocate memory
  *
  * @date 2019.11.01.
  */
-bool readBorder(Border *border, const int windowY){
-    FILE *fp;
-    fp = fopen("hatar.txt", "r");
-
-    //Error handling
-    if (fp == NULL){
-        printf("Error with opening file: hatar.txt");
+bool readBorder(Border *border, const int windowY, const char *filename){
+    double *coordinates;
+    int num;
+    IngestReport report;
+    if (!ingestCoordinates(filename, 0, &coordinates, &num, &report))
+        return false;
+    printIngestReport(filename, &report);
+
+    border->x = (Sint16*) malloc(num * sizeof(Sint16));
+    border->y = (Sint16*) malloc(num * sizeof(Sint16));
+    if ((border->x == NULL || border->y == NULL) && num != 0){
+        free(border->x);
+        free(border->y);
+        free(coordinates);
         return false;
     }
-
-    int num = 0;
-    border->x = (Sint16*) malloc(0 * sizeof(Sint16));
-    border->y = (Sint16*) malloc(0 * sizeof(Sint16));
-    double tempX, tempY;
-
-    while (fscanf(fp, "%lf %lf", &tempX, &tempY) == 2){
+    for (int i = 0; i < num; ++i) {
+        double tempX = coordinates[2*i], tempY = coordinates[2*i + 1];
         dataManipulation(&tempX, &tempY);
-        num++;
-        Sint16* tempXArr = (Sint16*) realloc(border->x, num * sizeof(Sint16));
-        Sint16* tempYArr = (Sint16*) realloc(border->y, num * sizeof(Sint16));
-        if (tempXArr == NULL || tempYArr == NULL){
-            free(border->x);
-            free(border->y);
-            return false;
-        }
-        border->x = tempXArr;
-        border->y = tempYArr;
-        border->x[num-1] = (Sint16) tempX;
-        border->y[num-1] = (Sint16) (windowY - tempY);
+        border->x[i] = (Sint16) tempX;
+        border->y[i] = (Sint16) (windowY - tempY);
     }
     border->size = num;
 
-    fclose(fp);
+    free(coordinates);
     return true;
 }
-
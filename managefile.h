@@ -4,14 +4,21 @@
 
 #include <stdbool.h>
 #include <SDL.h>
+#include "managegraph.h"
 
 #ifndef MANAGEFILE_H
 #define MANAGEFILE_H
 
+//The default largest number of a place, a wrong number in csp.txt cannot make the array of the places larger
+#define MAX_PLACES 10000000
+
+//The size of the name of a place with the '\0'
+#define NAME_LENGTH 51
+
 typedef struct {
     int num;
     double x, y;
-    char name[51];
+    char name[NAME_LENGTH];
 }Location;
 
 typedef struct{
@@ -24,9 +31,17 @@ typedef struct{
     Sint16 *x, *y;
 }Border;
 
-bool readGraph(double **data, const int size);
-bool readPosition(Position *position);
-bool readBorder(Border *border, const int windowY);
+//The paths of the data files: szak.txt, csp.txt and hatar.txt by default
+typedef struct{
+    const char *graph, *places, *border;
+    int maxPlaces;      //the largest number of a place, MAX_PLACES by default
+}DataFiles;
+
+bool readGraph(double **data, const int size, const char *filename);
+bool readAdjacency(AdjacencyList *adjacency, const int size, const char *filename);
+bool readPosition(Position *position, const int maxNum, const char *filename);
+bool readBorder(Border *border, const int windowY, const char *filename);
+void originalCoordinates(const Location place, double *x, double *y);
 
 #endif //MANAGEFILE_H
 
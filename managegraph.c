@@ -8,6 +8,7 @@
 
 #include "managegraph.h"
 #include "managefile.h"
+#include "minheap.h"
 #include "../debugmalloc.h"
 
 typedef struct {
@@ -82,7 +83,7 @@ int* dijkstraAlgorithm(const Graph graph, int startPoint, int endPoint, double *
          * If that distance is smaller than the known one, which is in the distance array, we
          * update the array with the calculated distance, and the previous vertex with the current one.
          */
-        for (int i = 0; i <= graph.size; ++i) {
+        for (int i = 0; i < graph.size; ++i) {
             if (graph.values[current][i] != 0 && graph.values[current][i] != DBL_MAX){
                 double weight = distance[current].value + graph.values[current][i];
                 if (weight < distance[i].value){
@@ -166,20 +167,23 @@ int* dijkstraAlgorithm(const Graph graph, int startPoint, int endPoint, double *
 
 /*
  * @param size is the size of the graph
+ * @param filename is the path of the szak.txt style file
  * @return graph is the created graph with DBL_MAX or actual value at each position
  *
  * @date 2019.11.03.
  */
-double** initGraph(int size){
+double** initGraph(int size, const char *filename){
     //Create empty 2D array
     double **graph = (double**) malloc(size * sizeof(double*));
     if (graph == NULL)
         return NULL;
-    graph[0] = (double*) malloc(size * size * sizeof(double));
-    if (graph[0] == NULL)
+    graph[0] = (double*) malloc((size_t) size * size * sizeof(double));
+    if (graph[0] == NULL){
+        free(graph);
         return NULL;
+    }
     for (int i = 1; i < size; ++i) {
-        graph[i] = graph[0] + i * size;
+        graph[i] = graph[0] + (size_t) i * size;
     }
     //Fill it with infinity, DBL_MAX
     for (int i = 0; i < size; ++i) {
@@ -191,7 +195,7 @@ double** initGraph(int size){
      * managefile.c function
      * Fills graph with actual value from szak.txt
      */
-    if (!readGraph(graph, size)){
+    if (!readGraph(graph, size, filename)){
         free(graph[0]);
         free(graph);
         return NULL;
@@ -201,3 +205,158 @@ double** initGraph(int size){
 }
 
 
+
+/*
+ * Collects the neighbours of every vertex from the adjacency matrix, so the searches
+ * only have to look at the existing edges instead of a whole row of the matrix
+ * @param graph is the graph with the adjacency matrix
+ * @param adjacency is where the lists are built
+ * @return false if unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+bool buildAdjacency(const Graph graph, AdjacencyList *adjacency){
+    adjacency->size = graph.size;
+    adjacency->offsets = (int*) malloc((graph.size + 1) * sizeof(int));
+    if (adjacency->offsets == NULL)
+        return false;
+    //First counting the edges, then filling the lists
+    int edges = 0;
+    for (int i = 0; i < graph.size; ++i) {
+        adjacency->offsets[i] = edges;
+        for (int j = 0; j < graph.size; ++j) {
+            if (graph.values[i][j] != 0 && graph.values[i][j] != DBL_MAX)
+                edges++;
+        }
+    }
+    adjacency->offsets[graph.size] = edges;
+    adjacency->targets = (int*) malloc(edges * sizeof(int));
+    adjacency->weights = (double*) malloc(edges * sizeof(double));
+    if ((adjacency->targets == NULL || adjacency->weights == NULL) && edges != 0){
+        freeAdjacency(adjacency);
+        return false;
+    }
+    int edge = 0;
+    for (int i = 0; i < graph.size; ++i) {
+        for (int j = 0; j < graph.size; ++j) {
+            if (graph.values[i][j] != 0 && graph.values[i][j] != DBL_MAX){
+                adjacency->targets[edge] = j;
+                adjacency->weights[edge] = graph.values[i][j];
+                edge++;
+            }
+        }
+    }
+    return true;
+}
+
+void freeAdjacency(AdjacencyList *adjacency){
+    free(adjacency->offsets);
+    free(adjacency->targets);
+    free(adjacency->weights);
+    adjacency->offsets = NULL;
+    adjacency->targets = NULL;
+    adjacency->weights = NULL;
+}
+
+/*
+ * Dijkstra algorithm with a binary heap from one vertex until endPoint is finished
+ * @param endPoint is the vertex where the search stops, -1: the search reaches every vertex
+ * The distances and the previous vertexes are final only for the finished vertexes.
+ *
+ * @date 2026.10.19.
+ */
+static bool searchTree(const AdjacencyList *adjacency, int startPoint, int endPoint, double *dist, int *prev){
+    for (int i = 0; i < adjacency->size; ++i) {
+        dist[i] = DBL_MAX;
+        if (prev != NULL)
+            prev[i] = -1;
+    }
+    MinHeap heap;
+    if (!initHeap(&heap, adjacency->size))
+        return false;
+    dist[startPoint] = 0;
+    if (prev != NULL)
+        prev[startPoint] = startPoint;
+    pushHeap(&heap, 0, startPoint);
+    while (heap.size > 0){
+        HeapItem item = popHeap(&heap);
+        //Outdated item, the vertex has already been finished with a shorter distance
+        if (item.key > dist[item.vertex])
+            continue;
+        if (item.vertex == endPoint)
+            break;
+        for (int e = adjacency->offsets[item.vertex]; e < adjacency->offsets[item.vertex + 1]; ++e) {
+            int next = adjacency->targets[e];
+            double weight = item.key + adjacency->weights[e];
+            if (weight < dist[next]){
+                dist[next] = weight;
+                if (prev != NULL)
+                    prev[next] = item.vertex;
+                if (!pushHeap(&heap, weight, next)){
+                    freeHeap(&heap);
+                    return false;
+                }
+            }
+        }
+    }
+    freeHeap(&heap);
+    return true;
+}
+
+/*
+ * Dijkstra algorithm from one vertex to all the others with a binary heap
+ * @param adjacency is the graph as neighbour lists
+ * @param startPoint of the search
+ * @param dist is an array of adjacency->size, the shortest distances are placed here (DBL_MAX: unreachable)
+ * @param prev is an array of adjacency->size or NULL, the previous vertex on the shortest path
+ * (-1: unreachable, the startPoint's is itself)
+ * @return false if unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+bool shortestPathTree(const AdjacencyList *adjacency, int startPoint, double *dist, int *prev){
+    return searchTree(adjacency, startPoint, -1, dist, prev);
+}
+
+/*
+ * Shortest route between two vertexes on the neighbour lists, the search stops when endPoint is reached
+ * @param adjacency is the graph as neighbour lists
+ * @param startPoint and endPoint are the ends of the route
+ * @param dist the overall shortest distance will be placed here
+ *
+ * @return the same as dijkstraAlgorithm: the vertexes through the shortest way in reversed order, -1 signs the end
+ * Not-normal return values:
+ *  - only -1: no connection between the two vertexes
+ *  - NULL: error with malloc
+ *
+ * @date 2026.10.19.
+ */
+int* shortestRoute(const AdjacencyList *adjacency, int startPoint, int endPoint, double *dist){
+    double *distance = (double*) malloc(adjacency->size * sizeof(double));
+    int *prev = (int*) malloc(adjacency->size * sizeof(int));
+    if (distance == NULL || prev == NULL || !searchTree(adjacency, startPoint, endPoint, distance, prev)){
+        free(distance);
+        free(prev);
+        return NULL;
+    }
+    int length = 0;
+    if (prev[endPoint] != -1){
+        for (int vertex = endPoint; vertex != startPoint; vertex = prev[vertex])
+            length++;
+        length++;
+    }
+    int *route = (int*) malloc((length + 1) * sizeof(int));
+    if (route != NULL){
+        int vertex = endPoint;
+        for (int i = 0; i < length; ++i) {
+            route[i] = vertex;
+            vertex = prev[vertex];
+        }
+        route[length] = -1;
+        if (length > 0)
+            *dist = distance[endPoint];
+    }
+    free(distance);
+    free(prev);
+    return route;
+}
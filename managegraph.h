@@ -5,13 +5,30 @@
 #ifndef MANAGEGRAPH_H
 #define MANAGEGRAPH_H
 
+#include <stdbool.h>
+
 typedef struct{
     int size;
     double **values;
 }Graph;
 
+/*
+ * The same graph as lists of neighbours (compressed sparse row):
+ * the neighbours of vertex v are targets[offsets[v]] ... targets[offsets[v+1]-1]
+ */
+typedef struct{
+    int size;
+    int *offsets;
+    int *targets;
+    double *weights;
+}AdjacencyList;
+
 int* dijkstraAlgorithm(const Graph graph, int startPoint, int endPoint, double *dist);
-double** initGraph(int size);
+double** initGraph(int size, const char *filename);
+bool buildAdjacency(const Graph graph, AdjacencyList *adjacency);
+void freeAdjacency(AdjacencyList *adjacency);
+bool shortestPathTree(const AdjacencyList *adjacency, int startPoint, double *dist, int *prev);
+int* shortestRoute(const AdjacencyList *adjacency, int startPoint, int endPoint, double *dist);
 
 #endif //MANAGEGRAPH_H
 
@@ -0,0 +1,88 @@
+//
+// Created by Mark on 10/19/2026
+//
+// Binary min-heap for the priority queue based searches
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#include "minheap.h"
+#include "../debugmalloc.h"
+
+/*
+ * The heap has no decrease-key operation: when a vertex gets a shorter distance it is simply pushed again.
+ * The searches skip the popped items whose key is bigger than the vertex's known distance.
+ */
+
+/*
+ * @param heap is the heap to initialize
+ * @param capacity is the initial capacity, the heap grows when it is needed
+ * @return false if unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+bool initHeap(MinHeap *heap, int capacity){
+    if (capacity < 1)
+        capacity = 1;
+    heap->size = 0;
+    heap->capacity = capacity;
+    heap->items = (HeapItem*) malloc(capacity * sizeof(HeapItem));
+    return heap->items != NULL;
+}
+
+/*
+ * @param heap is the heap
+ * @param key is the priority, the smallest one is popped first
+ * @param vertex belongs to the key
+ * @return false if unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+bool pushHeap(MinHeap *heap, double key, int vertex){
+    if (heap->size == heap->capacity){
+        HeapItem *temp = (HeapItem*) realloc(heap->items, 2 * heap->capacity * sizeof(HeapItem));
+        if (temp == NULL)
+            return false;
+        heap->items = temp;
+        heap->capacity *= 2;
+    }
+    //Moving the new item up from the bottom while its parent is bigger
+    int i = heap->size++;
+    while (i > 0 && heap->items[(i-1) / 2].key > key){
+        heap->items[i] = heap->items[(i-1) / 2];
+        i = (i-1) / 2;
+    }
+    heap->items[i].key = key;
+    heap->items[i].vertex = vertex;
+    return true;
+}
+
+/*
+ * @param heap is a non-empty heap
+ * @return the item with the smallest key, which is removed from the heap
+ *
+ * @date 2026.10.19.
+ */
+HeapItem popHeap(MinHeap *heap){
+    HeapItem top = heap->items[0];
+    HeapItem last = heap->items[--heap->size];
+    //Moving the last item down from the top while one of its children is smaller
+    int i = 0;
+    while (2*i + 1 < heap->size){
+        int child = 2*i + 1;
+        if (child + 1 < heap->size && heap->items[child+1].key < heap->items[child].key)
+            child++;
+        if (heap->items[child].key >= last.key)
+            break;
+        heap->items[i] = heap->items[child];
+        i = child;
+    }
+    heap->items[i] = last;
+    return top;
+}
+
+void freeHeap(MinHeap *heap){
+    free(heap->items);
+    heap->items = NULL;
+    heap->size = heap->capacity = 0;
+}
@@ -0,0 +1,25 @@
+//
+// Created by Mark on 10/19/2026
+//
+
+#include <stdbool.h>
+
+#ifndef MINHEAP_H
+#define MINHEAP_H
+
+typedef struct{
+    double key;
+    int vertex;
+}HeapItem;
+
+typedef struct{
+    int size, capacity;
+    HeapItem *items;
+}MinHeap;
+
+bool initHeap(MinHeap *heap, int capacity);
+bool pushHeap(MinHeap *heap, double key, int vertex);
+HeapItem popHeap(MinHeap *heap);
+void freeHeap(MinHeap *heap);
+
+#endif //MINHEAP_H
@@ -0,0 +1,221 @@
+//
+// Created by Mark on 10/19/2026
+//
+// Looking up places by name or by the beginning of the name
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "placeindex.h"
+#include "managefile.h"
+#include "../debugmalloc.h"
+
+typedef struct{
+    const char *name;
+    int vertex;
+}SortItem;
+
+/*
+ * Converts a name to the form used in the index: lower case letters become upper case, and the Hungarian
+ * accented letters (UTF-8) lose their accents, so "Győr", "GYÕR" and "gyor" are all "GYOR".
+ * Unknown multi-byte characters are left out.
+ * @param text is the name
+ * @param result is where the normalized name is placed
+ * @param size is the size of result
+ *
+ * @date 2026.10.19.
+ */
+void normalizePlaceName(const char *text, char *result, int size){
+    //Second bytes after 0xC3 (á, é, í, ó, ö, ú, ü and the capitals) and their letters
+    static const unsigned char accented[] = {0xA1, 0x81, 0xA9, 0x89, 0xAD, 0x8D, 0xB3, 0x93, 0xB6, 0x96, 0xB5, 0x95,
+                                             0xBA, 0x9A, 0xBC, 0x9C};
+    static const char letters[] = "AAEEIIOOOOOOUUUU";
+    int length = 0;
+    const unsigned char *p = (const unsigned char*) text;
+    while (*p != '\0' && length < size - 1){
+        char letter = 0;
+        if (*p < 0x80){
+            letter = (*p >= 'a' && *p <= 'z') ? (char) (*p - 'a' + 'A') : (char) *p;
+            p++;
+        } else if (*p == 0xC3 && p[1] != '\0'){
+            for (int i = 0; i < (int) sizeof(accented); ++i) {
+                if (p[1] == accented[i])
+                    letter = letters[i];
+            }
+            p += 2;
+        } else if (*p == 0xC5 && (p[1] == 0x90 || p[1] == 0x91)){
+            letter = 'O';   //ő, Ő
+            p += 2;
+        } else if (*p == 0xC5 && (p[1] == 0xB0 || p[1] == 0xB1)){
+            letter = 'U';   //ű, Ű
+            p += 2;
+        } else{
+            //Skipping the whole unknown character
+            p++;
+            while ((*p & 0xC0) == 0x80)
+                p++;
+        }
+        if (letter != 0)
+            result[length++] = letter;
+    }
+    result[length] = '\0';
+}
+
+static uint32_t hashName(const char *name){
+    //FNV-1a
+    uint32_t hash = 2166136261u;
+    for (const unsigned char *p = (const unsigned char*) name; *p != '\0'; ++p) {
+        hash ^= *p;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static const char* nameOf(const PlaceIndex *index, int vertex){
+    return index->strings + index->nameAt[vertex];
+}
+
+static int compareNames(const void *a, const void *b){
+    const SortItem *first = (const SortItem*) a;
+    const SortItem *second = (const SortItem*) b;
+    int result = strcmp(first->name, second->name);
+    if (result != 0)
+        return result;
+    return first->vertex - second->vertex;
+}
+
+/*
+ * Builds the index of the place names
+ * @param position is the vertex array
+ * @param index is where the index is built, free it with freePlaceIndex
+ * @return false if unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+bool buildPlaceIndex(const Position position, PlaceIndex *index){
+    index->size = position.size;
+    index->count = 0;
+    index->hashSize = 16;
+    while (index->hashSize < 2 * position.size)
+        index->hashSize *= 2;
+    index->strings = (char*) malloc((size_t) position.size * NAME_LENGTH + 1);
+    index->nameAt = (int*) malloc(position.size * sizeof(int));
+    index->sorted = (int*) malloc(position.size * sizeof(int));
+    index->hashTable = (int*) malloc(index->hashSize * sizeof(int));
+    if (index->strings == NULL || index->nameAt == NULL || index->sorted == NULL || index->hashTable == NULL){
+        freePlaceIndex(index);
+        return false;
+    }
+    for (int i = 0; i < index->hashSize; ++i)
+        index->hashTable[i] = -1;
+
+    int used = 0;
+    for (int i = 0; i < position.size; ++i) {
+        index->nameAt[i] = -1;
+        //The place numbers of csp.txt start from 1, the missing ones are not real places
+        if (position.values[i].num != i + 1)
+            continue;
+        char name[NAME_LENGTH];
+        normalizePlaceName(position.values[i].name, name, sizeof(name));
+        uint32_t slot = hashName(name) & (index->hashSize - 1);
+        while (index->hashTable[slot] != -1 && strcmp(nameOf(index, index->hashTable[slot]), name) != 0)
+            slot = (slot + 1) & (index->hashSize - 1);
+        if (index->hashTable[slot] != -1){
+            //Same name again: the string is shared, the first place keeps the exact match
+            index->nameAt[i] = index->nameAt[index->hashTable[slot]];
+        } else{
+            index->nameAt[i] = used;
+            strcpy(index->strings + used, name);
+            used += (int) strlen(name) + 1;
+            index->hashTable[slot] = i;
+        }
+        index->sorted[index->count++] = i;
+    }
+    char *temp = (char*) realloc(index->strings, used + 1);
+    if (temp != NULL)
+        index->strings = temp;
+
+    SortItem *items = (SortItem*) malloc((index->count > 0 ? index->count : 1) * sizeof(SortItem));
+    if (items == NULL){
+        freePlaceIndex(index);
+        return false;
+    }
+    for (int i = 0; i < index->count; ++i) {
+        items[i].name = nameOf(index, index->sorted[i]);
+        items[i].vertex = index->sorted[i];
+    }
+    qsort(items, index->count, sizeof(SortItem), compareNames);
+    for (int i = 0; i < index->count; ++i)
+        index->sorted[i] = items[i].vertex;
+    free(items);
+    return true;
+}
+
+/*
+ * @param index is the index of the names
+ * @param name is the name of the place, in any case, with or without accents
+ * @return the vertex of the place, -1 if there is no such place
+ *
+ * @date 2026.10.19.
+ */
+int findPlace(const PlaceIndex *index, const char *name){
+    char normalized[NAME_LENGTH];
+    normalizePlaceName(name, normalized, sizeof(normalized));
+    uint32_t slot = hashName(normalized) & (index->hashSize - 1);
+    while (index->hashTable[slot] != -1){
+        if (strcmp(nameOf(index, index->hashTable[slot]), normalized) == 0)
+            return index->hashTable[slot];
+        slot = (slot + 1) & (index->hashSize - 1);
+    }
+    return -1;
+}
+
+/*
+ * Finds the places whose name begins with the prefix (binary search in the sorted names)
+ * @param index is the index of the names
+ * @param prefix is the beginning of the name, in any case, with or without accents
+ * @param first gets where the matches begin in index->sorted
+ * @return the number of matches, they are index->sorted[*first] ... index->sorted[*first + count - 1] in alphabetical order
+ *
+ * @date 2026.10.19.
+ */
+int findPlacesByPrefix(const PlaceIndex *index, const char *prefix, int *first){
+    char normalized[NAME_LENGTH];
+    normalizePlaceName(prefix, normalized, sizeof(normalized));
+    size_t length = strlen(normalized);
+
+    //The first name which is not smaller than the prefix
+    int low = 0, high = index->count;
+    while (low < high){
+        int middle = (low + high) / 2;
+        if (strcmp(nameOf(index, index->sorted[middle]), normalized) < 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    *first = low;
+    //The last name which begins with the prefix
+    high = index->count;
+    int start = low;
+    while (low < high){
+        int middle = (low + high) / 2;
+        if (strncmp(nameOf(index, index->sorted[middle]), normalized, length) == 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low - start;
+}
+
+void freePlaceIndex(PlaceIndex *index){
+    free(index->strings);
+    free(index->nameAt);
+    free(index->sorted);
+    free(index->hashTable);
+    index->strings = NULL;
+    index->nameAt = NULL;
+    index->sorted = NULL;
+    index->hashTable = NULL;
+}
@@ -0,0 +1,33 @@
+//
+// Created by Mark on 10/19/2026
+//
+
+#include <stdbool.h>
+#include "managefile.h"
+
+#ifndef PLACEINDEX_H
+#define PLACEINDEX_H
+
+/*
+ * Index of the place names. The names are normalized (upper case, without accents), and every
+ * distinct normalized name is stored once in the strings table.
+ *  - exact lookup: hash table of the vertexes with open addressing
+ *  - prefix lookup: the vertexes sorted by their normalized name, the matches are next to each other
+ */
+typedef struct{
+    int size;           //size of the position array
+    int count;          //number of indexed places
+    char *strings;
+    int *nameAt;        //where the normalized name of a vertex begins in strings, -1: no such place
+    int *sorted;
+    int *hashTable;     //vertexes, -1: empty slot
+    int hashSize;       //power of two
+}PlaceIndex;
+
+void normalizePlaceName(const char *text, char *result, int size);
+bool buildPlaceIndex(const Position position, PlaceIndex *index);
+int findPlace(const PlaceIndex *index, const char *name);
+int findPlacesByPrefix(const PlaceIndex *index, const char *prefix, int *first);
+void freePlaceIndex(PlaceIndex *index);
+
+#endif //PLACEINDEX_H
@@ -0,0 +1,190 @@
+//
+// Created by Mark on 10/19/2026
+//
+// Route planning on a worker thread, the legs are streamed back to the UI
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+
+#include "planthread.h"
+#include "managegraph.h"
+#include "../debugmalloc.h"
+
+/*
+ * The UI and the worker share a single-producer single-consumer queue.
+ * There is a slot for every leg, therefore the worker never has to wait for the UI:
+ * it fills the next slot, then publishes it by increasing the produced counter.
+ * The UI reads the slots below the produced counter. No locks are needed.
+ */
+
+/*
+ * Wakes up the UI's SDL_WaitEvent, the event carries the planner which sent it
+ * @param planner is the sender
+ *
+ * @date 2026.10.19.
+ */
+static void notifyUI(Planner *planner){
+    SDL_Event event;
+    SDL_zero(event);
+    event.type = planner->eventType;
+    event.user.data1 = planner;
+    SDL_PushEvent(&event);
+}
+
+/*
+ * The worker thread: runs shortestRoute for every leg in order until it is done or cancelled
+ * @param data is the planner
+ *
+ * @date 2026.10.19.
+ */
+static int planningThread(void *data){
+    Planner *planner = (Planner*) data;
+    for (int i = 1; i <= planner->legs; ++i){
+        if (SDL_AtomicGet(&planner->cancel))
+            break;
+        PlannedLeg *leg = &planner->queue[i-1];
+        leg->leg = i;
+        leg->distance = 0;
+        Uint64 start = SDL_GetPerformanceCounter();
+        leg->route = shortestRoute(planner->adjacency, planner->points[i-1], planner->points[i], &leg->distance);
+        leg->time = (double) (SDL_GetPerformanceCounter() - start) * 1000.0 / (double) SDL_GetPerformanceFrequency();
+        //The slot has to be written completely before the UI can see it
+        SDL_MemoryBarrierRelease();
+        SDL_AtomicSet(&planner->produced, i);
+        notifyUI(planner);
+        //Malloc error, the UI handles it as a fatal error
+        if (leg->route == NULL)
+            break;
+    }
+    SDL_AtomicSet(&planner->finished, 1);
+    notifyUI(planner);
+    return 0;
+}
+
+/*
+ * Starts planning the route through the chosen points on a new thread
+ * @param adjacency is the graph as neighbour lists, it must not be freed until the planner is freed
+ * @param points are the chosen vertexes in order, the planner makes a copy of them
+ * @param count is the number of chosen vertexes, at least 2
+ * @param eventType is the SDL user event pushed when a new leg is ready or the worker is finished
+ *
+ * @return the planner, NULL if unable to allocate memory or to create the thread
+ *
+ * @date 2026.10.19.
+ */
+Planner* startPlanning(const AdjacencyList *adjacency, const int *points, int count, Uint32 eventType){
+    Planner *planner = (Planner*) malloc(sizeof(Planner));
+    if (planner == NULL)
+        return NULL;
+    planner->legs = count - 1;
+    planner->points = (int*) malloc(count * sizeof(int));
+    planner->queue = (PlannedLeg*) malloc(planner->legs * sizeof(PlannedLeg));
+    if (planner->points == NULL || planner->queue == NULL){
+        free(planner->points);
+        free(planner->queue);
+        free(planner);
+        return NULL;
+    }
+    memcpy(planner->points, points, count * sizeof(int));
+    SDL_AtomicSet(&planner->cancel, 0);
+    SDL_AtomicSet(&planner->finished, 0);
+    SDL_AtomicSet(&planner->produced, 0);
+    planner->consumed = 0;
+    planner->adjacency = adjacency;
+    planner->eventType = eventType;
+    planner->next = NULL;
+
+    planner->thread = SDL_CreateThread(planningThread, "planner", planner);
+    if (planner->thread == NULL){
+        free(planner->points);
+        free(planner->queue);
+        free(planner);
+        return NULL;
+    }
+    return planner;
+}
+
+/*
+ * Takes the next finished leg out of the queue. The caller becomes the owner of leg->route.
+ * @param planner is the running planner
+ * @param leg is where the leg is copied
+ * @return whether there was a finished leg
+ *
+ * @date 2026.10.19.
+ */
+bool nextPlannedLeg(Planner *planner, PlannedLeg *leg){
+    int produced = SDL_AtomicGet(&planner->produced);
+    SDL_MemoryBarrierAcquire();
+    if (planner->consumed >= produced)
+        return false;
+    *leg = planner->queue[planner->consumed];
+    planner->queue[planner->consumed].route = NULL;
+    planner->consumed++;
+    return true;
+}
+
+/*
+ * @param planner is the running planner
+ * @return whether the worker has returned and all of its legs were taken out
+ *
+ * @date 2026.10.19.
+ */
+bool planningFinished(Planner *planner){
+    if (!SDL_AtomicGet(&planner->finished))
+        return false;
+    return planner->consumed >= SDL_AtomicGet(&planner->produced);
+}
+
+/*
+ * Waits for the worker thread, then frees the planner with the legs the UI did not take out
+ * @param planner is the planner to free
+ *
+ * @date 2026.10.19.
+ */
+void freePlanner(Planner *planner){
+    SDL_WaitThread(planner->thread, NULL);
+    int produced = SDL_AtomicGet(&planner->produced);
+    for (int i = planner->consumed; i < produced; ++i)
+        free(planner->queue[i].route);
+    free(planner->queue);
+    free(planner->points);
+    free(planner);
+}
+
+/*
+ * Asks the worker to stop before the next leg. The UI must not wait for the leg in progress,
+ * therefore the planner is put on the retired list, and it is freed later by reapPlanners.
+ * @param planner is the planner to cancel
+ * @param retired is the list of the already cancelled planners
+ * @return the new head of the retired list
+ *
+ * @date 2026.10.19.
+ */
+Planner* cancelPlanning(Planner *planner, Planner *retired){
+    SDL_AtomicSet(&planner->cancel, 1);
+    planner->next = retired;
+    return planner;
+}
+
+/*
+ * Frees the cancelled planners whose thread has already returned
+ * @param retired is the list of the cancelled planners
+ * @param wait if true, all of them are freed, waiting for the running ones (when quitting)
+ * @return the new head of the retired list
+ *
+ * @date 2026.10.19.
+ */
+Planner* reapPlanners(Planner *retired, bool wait){
+    Planner **pp = &retired;
+    while (*pp != NULL){
+        Planner *planner = *pp;
+        if (wait || SDL_AtomicGet(&planner->finished)){
+            *pp = planner->next;
+            freePlanner(planner);
+        } else
+            pp = &planner->next;
+    }
+    return retired;
+}
@@ -0,0 +1,40 @@
+//
+// Created by Mark on 10/19/2026
+//
+
+#include <stdbool.h>
+#include <SDL2/SDL.h>
+#include "managegraph.h"
+
+#ifndef PLANTHREAD_H
+#define PLANTHREAD_H
+
+typedef struct{
+    int leg;            //1 is the leg between the first and the second chosen point
+    int *route;         //result of shortestRoute, NULL if it failed
+    double distance;
+    double time;        //milliseconds spent in shortestRoute
+}PlannedLeg;
+
+typedef struct Planner{
+    SDL_Thread *thread;
+    SDL_atomic_t cancel;    //set by the UI, checked by the worker before every leg
+    SDL_atomic_t finished;  //set by the worker when it returns
+    SDL_atomic_t produced;  //number of legs published by the worker
+    int consumed;           //number of legs taken out by the UI, only the UI touches it
+    int legs;
+    PlannedLeg *queue;
+    const AdjacencyList *adjacency;
+    int *points;
+    Uint32 eventType;
+    struct Planner *next;   //chaining of the cancelled planners
+}Planner;
+
+Planner* startPlanning(const AdjacencyList *adjacency, const int *points, int count, Uint32 eventType);
+bool nextPlannedLeg(Planner *planner, PlannedLeg *leg);
+bool planningFinished(Planner *planner);
+void freePlanner(Planner *planner);
+Planner* cancelPlanning(Planner *planner, Planner *retired);
+Planner* reapPlanners(Planner *retired, bool wait);
+
+#endif //PLANTHREAD_H
@@ -0,0 +1,415 @@
+//
+// Created by Mark on 10/19/2026
+//
+// Writing the planned routes to a file as GeoJSON or in a binary format, one route after the other
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdarg.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+
+#include "routewriter.h"
+#include "managefile.h"
+#include "../debugmalloc.h"
+
+/*
+ * Only the route being written is kept in memory, it is written to the file by endRoute.
+ * The points are in the coordinates of csp.txt (EOV, EPSG:23700), not in the pixels of the window.
+ *
+ * A leg without connection breaks the line, the next leg starts a new part: the geometry of a route is a list
+ * of parts, every part is a list of at least two points. A part with a single point (e.g. a leg between the same
+ * places before a leg without connection) is left out, it is not a valid line.
+ *
+ * GeoJSON: a FeatureCollection, every route is a Feature with a MultiLineString geometry. Its properties are
+ * the distance of the route, the names of the chosen places and the legs (from, to, distance).
+ *
+ * Binary (byte order of the machine): "RPRT", uint32 version (2), then a record for every route:
+ *  - uint32 length of the rest of the record in bytes
+ *  - uint32 number of legs, uint32 number of points, uint32 number of parts, double distance of the route
+ *  - for every leg: int32 from, int32 to, double distance
+ *  - for every chosen place: uint8 length of the name, the name without '\0'
+ *  - for every part: uint32 number of points
+ *  - for every point: int32 vertex, double x, double y
+ * The vertexes are numbered from 1 as in the files, a negative distance signs that there is no connection.
+ */
+
+#define OUTPUT_BUFFER (1 << 20)
+
+/*
+ * Appends bytes to the buffer, its capacity is doubled if needed
+ * @return false if unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+static bool appendBytes(ByteBuffer *buffer, const void *bytes, size_t size){
+    if (size == 0)
+        return true;
+    if (buffer->size + size > buffer->capacity){
+        size_t capacity = buffer->capacity == 0 ? 4096 : buffer->capacity;
+        while (capacity < buffer->size + size)
+            capacity *= 2;
+        char *values = (char*) realloc(buffer->values, capacity);
+        if (values == NULL)
+            return false;
+        buffer->values = values;
+        buffer->capacity = capacity;
+    }
+    memcpy(buffer->values + buffer->size, bytes, size);
+    buffer->size += size;
+    return true;
+}
+
+/*
+ * Appends formatted text to the buffer, the same as printf
+ * @return false if unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+static bool appendText(ByteBuffer *buffer, const char *format, ...){
+    char text[256];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(text, sizeof(text), format, args);
+    va_end(args);
+    if (length < 0 || length >= (int) sizeof(text))
+        return false;
+    return appendBytes(buffer, text, length);
+}
+
+/*
+ * Appends a number with two decimals, much faster than printf
+ * @return false if unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+static bool appendDecimal(ByteBuffer *buffer, double value){
+    char text[32];
+    int length = sizeof(text);
+    if (!(fabs(value) < 1e15))
+        return appendText(buffer, "%.2f", value);
+    long long hundredths = llround(fabs(value) * 100);
+    text[--length] = (char) ('0' + hundredths % 10);
+    text[--length] = (char) ('0' + hundredths / 10 % 10);
+    text[--length] = '.';
+    long long whole = hundredths / 100;
+    do {
+        text[--length] = (char) ('0' + whole % 10);
+        whole /= 10;
+    } while (whole > 0);
+    if (value < 0 && hundredths != 0)
+        text[--length] = '-';
+    return appendBytes(buffer, text + length, sizeof(text) - length);
+}
+
+/*
+ * Appends a JSON string with the necessary escapes, the UTF-8 characters are kept
+ * @return false if unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+static bool appendJsonString(ByteBuffer *buffer, const char *text){
+    bool success = appendBytes(buffer, "\"", 1);
+    for (const char *c = text; *c != '\0' && success; ++c) {
+        if (*c == '"' || *c == '\\'){
+            char escaped[2] = {'\\', *c};
+            success = appendBytes(buffer, escaped, 2);
+        } else if ((unsigned char) *c < 0x20)
+            success = appendText(buffer, "\\u%04x", (unsigned char) *c);
+        else
+            success = appendBytes(buffer, c, 1);
+    }
+    return success && appendBytes(buffer, "\"", 1);
+}
+
+static bool writeBytes(RouteWriter *writer, const void *bytes, size_t size){
+    if (fwrite(bytes, 1, size, writer->fp) != size)
+        return false;
+    writer->bytes += (long long) size;
+    return true;
+}
+
+/*
+ * The format of a file by its extension: .json and .geojson are GeoJSON, the others are binary
+ *
+ * @date 2026.10.19.
+ */
+RouteFormat routeFormatOf(const char *filename){
+    const char *extension = strrchr(filename, '.');
+    if (extension != NULL && (strcmp(extension, ".json") == 0 || strcmp(extension, ".geojson") == 0))
+        return ROUTE_GEOJSON;
+    return ROUTE_BINARY;
+}
+
+/*
+ * Creates the file and writes its header
+ * @param writer is the writer to set up
+ * @param filename is the path of the file
+ * @param format is the format of the file
+ * @return false if the file cannot be created
+ *
+ * @date 2026.10.19.
+ */
+bool openRouteWriter(RouteWriter *writer, const char *filename, RouteFormat format){
+    memset(writer, 0, sizeof(RouteWriter));
+    writer->format = format;
+    writer->lastVertex = -1;
+    writer->fp = fopen(filename, "wb");
+
+    //Error handling
+    if (writer->fp == NULL){
+        printf("Error with opening file: %s", filename);
+        return false;
+    }
+    //The routes are written in big blocks instead of many small ones
+    setvbuf(writer->fp, NULL, _IOFBF, OUTPUT_BUFFER);
+    bool success;
+    if (format == ROUTE_GEOJSON){
+        const char *header = "{\"type\":\"FeatureCollection\","
+                             "\"crs\":{\"type\":\"name\",\"properties\":{\"name\":\"urn:ogc:def:crs:EPSG::23700\"}},"
+                             "\"features\":[\n";
+        success = writeBytes(writer, header, strlen(header));
+    } else {
+        uint32_t version = 2;
+        success = writeBytes(writer, "RPRT", 4) && writeBytes(writer, &version, sizeof(version));
+    }
+    if (!success){
+        fclose(writer->fp);
+        writer->fp = NULL;
+    }
+    return success;
+}
+
+/*
+ * Starts a new route, the unfinished route (e.g. a cancelled planning) is dropped
+ *
+ * @date 2026.10.19.
+ */
+void beginRoute(RouteWriter *writer){
+    writer->head.size = 0;
+    writer->points.size = 0;
+    writer->pointCount = 0;
+    writer->lastVertex = -1;
+    writer->partLength = 0;
+    writer->partCount = 0;
+    writer->legCount = 0;
+}
+
+/*
+ * Appends a point of the route, the first point of a part starts a new part
+ * @return false if unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+static bool appendPoint(RouteWriter *writer, const Position position, int vertex, bool first){
+    if (first && writer->partCount == writer->partCapacity){
+        int capacity = writer->partCapacity == 0 ? 4 : 2 * writer->partCapacity;
+        uint32_t *parts = (uint32_t*) realloc(writer->parts, capacity * sizeof(uint32_t));
+        if (parts == NULL)
+            return false;
+        writer->parts = parts;
+        writer->partCapacity = capacity;
+    }
+    double x, y;
+    originalCoordinates(position.values[vertex], &x, &y);
+    bool success;
+    if (writer->format == ROUTE_GEOJSON){
+        if (first)
+            success = writer->partCount == 0 ? appendBytes(&writer->points, "[[", 2) : appendBytes(&writer->points, "],[[", 4);
+        else
+            success = appendBytes(&writer->points, ",[", 2);
+        success = success && appendDecimal(&writer->points, x) && appendBytes(&writer->points, ",", 1)
+                  && appendDecimal(&writer->points, y) && appendBytes(&writer->points, "]", 1);
+    }
+    else {
+        int32_t num = position.values[vertex].num;
+        success = appendBytes(&writer->points, &num, sizeof(num)) && appendBytes(&writer->points, &x, sizeof(x))
+                  && appendBytes(&writer->points, &y, sizeof(y));
+    }
+    if (!success)
+        return false;
+    if (first)
+        writer->parts[writer->partCount++] = 0;
+    writer->parts[writer->partCount - 1]++;
+    writer->pointCount++;
+    return true;
+}
+
+/*
+ * Adds a leg to the route
+ * @param writer is the writer
+ * @param position is the vertex array
+ * @param from and to are the chosen vertexes at the ends of the leg
+ * @param route is the result of shortestRoute: the vertexes in reversed order, -1 at the end
+ * @param distance is the length of the leg
+ * @return false if unable to allocate memory
+ *
+ * @date 2026.10.19.
+ */
+bool addRouteLeg(RouteWriter *writer, const Position position, int from, int to, const int *route, double distance){
+    if (writer->legCount == writer->legCapacity){
+        int capacity = writer->legCapacity == 0 ? 16 : 2 * writer->legCapacity;
+        RouteLegInfo *legs = (RouteLegInfo*) realloc(writer->legs, capacity * sizeof(RouteLegInfo));
+        if (legs == NULL){
+            writer->failed = true;
+            return false;
+        }
+        writer->legs = legs;
+        writer->legCapacity = capacity;
+    }
+    bool connected = route[0] != -1;
+    writer->legs[writer->legCount++] = (RouteLegInfo) {from, to, connected ? distance : DBL_MAX};
+    if (!connected){
+        //The next leg starts a new part, a single point of the current one is dropped
+        writer->lastVertex = -1;
+        writer->partLength = 0;
+        return true;
+    }
+
+    int length = 0;
+    while (route[length] != -1)
+        length++;
+    bool success = true;
+    //The first point of a leg is the last point of the previous one
+    for (int j = length - 1; j >= 0 && success; --j) {
+        int vertex = route[j];
+        if (vertex == writer->lastVertex)
+            continue;
+        //The first point of a part waits for the second one
+        if (writer->partLength == 1)
+            success = appendPoint(writer, position, writer->lastVertex, true);
+        if (writer->partLength >= 1)
+            success = success && appendPoint(writer, position, vertex, false);
+        writer->partLength++;
+        writer->lastVertex = vertex;
+    }
+    if (!success)
+        writer->failed = true;
+    return success;
+}
+
+/*
+ * The head of a GeoJSON feature: everything before the coordinates
+ *
+ * @date 2026.10.19.
+ */
+static bool geoJsonHead(RouteWriter *writer, const Position position, double distance){
+    ByteBuffer *head = &writer->head;
+    bool success = appendText(head, "%s{\"type\":\"Feature\",\"properties\":{\"distance\":", writer->routes > 0 ? ",\n" : "");
+    success = success && (distance == DBL_MAX ? appendText(head, "null") : appendDecimal(head, distance));
+    success = success && appendText(head, ",\"places\":[");
+    for (int i = 0; i <= writer->legCount && success; ++i) {
+        int vertex = i == 0 ? writer->legs[0].from : writer->legs[i-1].to;
+        success = (i == 0 || appendText(head, ",")) && appendJsonString(head, position.values[vertex].name);
+    }
+    success = success && appendText(head, "],\"legs\":[");
+    for (int i = 0; i < writer->legCount && success; ++i) {
+        const RouteLegInfo *leg = &writer->legs[i];
+        success = appendText(head, "%s{\"from\":%d,\"to\":%d,\"distance\":", i == 0 ? "" : ",",
+                             position.values[leg->from].num, position.values[leg->to].num);
+        success = success && (leg->distance == DBL_MAX ? appendText(head, "null") : appendDecimal(head, leg->distance))
+                  && appendText(head, "}");
+    }
+    success = success && appendText(head, "]},\"geometry\":");
+    if (writer->partCount > 0)
+        success = success && appendText(head, "{\"type\":\"MultiLineString\",\"coordinates\":[");
+    return success;
+}
+
+/*
+ * The head of a binary record: everything before the points
+ *
+ * @date 2026.10.19.
+ */
+static bool binaryHead(RouteWriter *writer, const Position position, double distance){
+    ByteBuffer *head = &writer->head;
+    uint32_t legCount = writer->legCount, pointCount = writer->pointCount, partCount = writer->partCount;
+    double routeDistance = distance == DBL_MAX ? -1 : distance;
+    bool success = appendBytes(head, &legCount, sizeof(legCount)) && appendBytes(head, &pointCount, sizeof(pointCount))
+                   && appendBytes(head, &partCount, sizeof(partCount)) && appendBytes(head, &routeDistance, sizeof(routeDistance));
+    for (int i = 0; i < writer->legCount && success; ++i) {
+        const RouteLegInfo *leg = &writer->legs[i];
+        int32_t from = position.values[leg->from].num, to = position.values[leg->to].num;
+        double legDistance = leg->distance == DBL_MAX ? -1 : leg->distance;
+        success = appendBytes(head, &from, sizeof(from)) && appendBytes(head, &to, sizeof(to))
+                  && appendBytes(head, &legDistance, sizeof(legDistance));
+    }
+    for (int i = 0; i <= writer->legCount && success; ++i) {
+        int vertex = i == 0 ? writer->legs[0].from : writer->legs[i-1].to;
+        uint8_t length = (uint8_t) strlen(position.values[vertex].name);
+        success = appendBytes(head, &length, 1) && appendBytes(head, position.values[vertex].name, length);
+    }
+    success = success && appendBytes(head, writer->parts, writer->partCount * sizeof(uint32_t));
+    return success;
+}
+
+/*
+ * Writes the route to the file
+ * @param writer is the writer
+ * @param position is the vertex array
+ * @return false if unable to allocate memory or to write the file
+ *
+ * @date 2026.10.19.
+ */
+bool endRoute(RouteWriter *writer, const Position position){
+    if (writer->failed)
+        return false;
+    if (writer->legCount == 0)
+        return true;
+    double distance = 0;
+    for (int i = 0; i < writer->legCount; ++i) {
+        if (writer->legs[i].distance == DBL_MAX)
+            distance = DBL_MAX;
+        if (distance != DBL_MAX)
+            distance += writer->legs[i].distance;
+    }
+
+    writer->head.size = 0;
+    bool success;
+    if (writer->format == ROUTE_GEOJSON){
+        success = geoJsonHead(writer, position, distance) && writeBytes(writer, writer->head.values, writer->head.size);
+        if (writer->partCount > 0)
+            success = success && writeBytes(writer, writer->points.values, writer->points.size) && writeBytes(writer, "]]}}", 4);
+        else
+            success = success && writeBytes(writer, "null}", 5);
+    } else {
+        success = binaryHead(writer, position, distance);
+        uint32_t length = (uint32_t) (writer->head.size + writer->points.size);
+        success = success && writeBytes(writer, &length, sizeof(length)) && writeBytes(writer, writer->head.values, writer->head.size)
+                  && writeBytes(writer, writer->points.values, writer->points.size);
+    }
+    if (!success){
+        writer->failed = true;
+        return false;
+    }
+    writer->routes++;
+    beginRoute(writer);
+    return true;
+}
+
+/*
+ * Finishes the file and frees the writer
+ * @return false if any of the routes could not be written
+ *
+ * @date 2026.10.19.
+ */
+bool closeRouteWriter(RouteWriter *writer){
+    bool success = !writer->failed;
+    if (writer->fp != NULL){
+        if (writer->format == ROUTE_GEOJSON)
+            success = writeBytes(writer, "\n]}\n", 4) && success;
+        success = fclose(writer->fp) == 0 && success;
+        writer->fp = NULL;
+    }
+    free(writer->head.values);
+    free(writer->points.values);
+    free(writer->parts);
+    free(writer->legs);
+    writer->head.values = writer->points.values = NULL;
+    writer->parts = NULL;
+    writer->legs = NULL;
+    return success;
+}
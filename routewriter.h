@@ -0,0 +1,52 @@
+//
+// Created by Mark on 10/19/2026
+//
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "managefile.h"
+
+#ifndef ROUTEWRITER_H
+#define ROUTEWRITER_H
+
+typedef enum{
+    ROUTE_GEOJSON,
+    ROUTE_BINARY
+}RouteFormat;
+
+typedef struct{
+    char *values;
+    size_t size, capacity;
+}ByteBuffer;
+
+typedef struct{
+    int from, to;       //vertexes
+    double distance;    //DBL_MAX if there is no connection
+}RouteLegInfo;
+
+typedef struct{
+    FILE *fp;
+    RouteFormat format;
+    long long routes;       //number of routes written
+    long long bytes;        //number of bytes written
+    //Only the route being written is kept in memory
+    ByteBuffer head, points;
+    int pointCount;
+    int lastVertex;
+    int partLength;         //points of the current part, its first point is written with the second one
+    uint32_t *parts;        //number of points of the written parts
+    int partCount, partCapacity;
+    RouteLegInfo *legs;
+    int legCount, legCapacity;
+    bool failed;
+}RouteWriter;
+
+RouteFormat routeFormatOf(const char *filename);
+bool openRouteWriter(RouteWriter *writer, const char *filename, RouteFormat format);
+void beginRoute(RouteWriter *writer);
+bool addRouteLeg(RouteWriter *writer, const Position position, int from, int to, const int *route, double distance);
+bool endRoute(RouteWriter *writer, const Position position);
+bool closeRouteWriter(RouteWriter *writer);
+
+#endif //ROUTEWRITER_H
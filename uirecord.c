@@ -0,0 +1,127 @@
+//
+// Created by Mark on 10/19/2026
+//
+// Recording the user's events to a file and reading them back for replaying the session
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <string.h>
+#include <SDL2/SDL.h>
+
+#include "uirecord.h"
+#include "../debugmalloc.h"
+
+/*
+ * Creates the recording file
+ * @param filename is the path of the file
+ * @return the opened file, NULL if it cannot be created
+ *
+ * @date 2026.10.19.
+ */
+FILE* startRecording(const char *filename){
+    FILE *fp;
+    fp = fopen(filename, "wb");
+
+    //Error handling
+    if (fp == NULL){
+        printf("Error with opening file: %s", filename);
+        return NULL;
+    }
+    if (fwrite("RPUI", 1, 4, fp) != 4){
+        fclose(fp);
+        return NULL;
+    }
+    return fp;
+}
+
+/*
+ * Writes an event to the recording if it is one of the user's: left click, text input, key press or quit
+ * @param fp is the recording file
+ * @param event is the SDL event
+ * @param time is the milliseconds since the start of the recording
+ * @return false if the writing failed
+ *
+ * @date 2026.10.19.
+ */
+bool recordEvent(FILE *fp, const SDL_Event *event, Uint32 time){
+    RecordedEvent recorded;
+    memset(&recorded, 0, sizeof(recorded));
+    recorded.time = time;
+    recorded.type = event->type;
+    switch (event->type){
+    case SDL_MOUSEBUTTONDOWN:
+        if (event->button.button != SDL_BUTTON_LEFT)
+            return true;
+        recorded.x = event->button.x;
+        recorded.y = event->button.y;
+        break;
+    case SDL_TEXTINPUT:
+        memcpy(recorded.text, event->text.text, sizeof(recorded.text));
+        recorded.text[sizeof(recorded.text) - 1] = '\0';
+        break;
+    case SDL_KEYDOWN:
+        recorded.key = event->key.keysym.sym;
+        break;
+    case SDL_QUIT:
+        break;
+    default:
+        return true;
+    }
+    return fwrite(&recorded, sizeof(recorded), 1, fp) == 1;
+}
+
+/*
+ * Opens a recording for replaying
+ * @param filename is the path of the file
+ * @return the opened file, NULL if it cannot be opened or it is not a recording
+ *
+ * @date 2026.10.19.
+ */
+FILE* openRecording(const char *filename){
+    FILE *fp;
+    fp = fopen(filename, "rb");
+
+    //Error handling
+    if (fp == NULL){
+        printf("Error with opening file: %s", filename);
+        return NULL;
+    }
+    char magic[4];
+    if (fread(magic, 1, 4, fp) != 4 || memcmp(magic, "RPUI", 4) != 0){
+        printf("Not a recording: %s", filename);
+        fclose(fp);
+        return NULL;
+    }
+    return fp;
+}
+
+/*
+ * Reads the next event of the recording
+ * @param fp is the recording file
+ * @param recorded gets the record
+ * @param event gets the SDL event made from the record
+ * @return false at the end of the file
+ *
+ * @date 2026.10.19.
+ */
+bool readRecordedEvent(FILE *fp, RecordedEvent *recorded, SDL_Event *event){
+    if (fread(recorded, sizeof(RecordedEvent), 1, fp) != 1)
+        return false;
+    recorded->text[sizeof(recorded->text) - 1] = '\0';
+    SDL_zero(*event);
+    event->type = recorded->type;
+    switch (recorded->type){
+    case SDL_MOUSEBUTTONDOWN:
+        event->button.button = SDL_BUTTON_LEFT;
+        event->button.x = recorded->x;
+        event->button.y = recorded->y;
+        break;
+    case SDL_TEXTINPUT:
+        memcpy(event->text.text, recorded->text, sizeof(recorded->text));
+        break;
+    case SDL_KEYDOWN:
+        event->key.keysym.sym = recorded->key;
+        break;
+    }
+    return true;
+}
@@ -0,0 +1,26 @@
+//
+// Created by Mark on 10/19/2026
+//
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <SDL2/SDL.h>
+
+#ifndef UIRECORD_H
+#define UIRECORD_H
+
+//One user event of a recorded session, the file is a "RPUI" header followed by these records
+typedef struct{
+    Uint32 time;        //milliseconds since the start of the recording
+    Uint32 type;        //SDL event type: SDL_MOUSEBUTTONDOWN, SDL_TEXTINPUT, SDL_KEYDOWN or SDL_QUIT
+    Sint32 x, y;        //place of the click
+    Sint32 key;         //key of the key press
+    char text[32];      //UTF-8 text of the text input
+}RecordedEvent;
+
+FILE* startRecording(const char *filename);
+bool recordEvent(FILE *fp, const SDL_Event *event, Uint32 time);
+FILE* openRecording(const char *filename);
+bool readRecordedEvent(FILE *fp, RecordedEvent *recorded, SDL_Event *event);
+
+#endif //UIRECORD_H